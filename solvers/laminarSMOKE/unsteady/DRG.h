@@ -55,6 +55,42 @@ namespace OpenSMOKE
 		*/
 		void Analysis(const double T, const double P_Pa, const OpenSMOKE::OpenSMOKEVectorDouble&);
 
+		/**
+		*@brief Performs the DRG analysis for the given point, reusing (if enabled) the important species of the
+		*       same point or of the last analyzed point if the state did not move beyond the reuse tolerances
+		*@param point index of the point (e.g. cell)
+		*@param T temperature in K
+		*@param P_Pa pressure in Pa
+		*@param c vector of concentrations in kmol/m3 (1-index based)
+		*/
+		void Analysis(const unsigned int point, const double T, const double P_Pa, const OpenSMOKE::OpenSMOKEVectorDouble& c);
+
+		/**
+		*@brief Enables the reuse of important species (the state is compared using temperature and mole fractions of key species)
+		*@param number_of_points total number of points (e.g. cells)
+		*@param temperature_tolerance max difference of temperature in K
+		*@param relative_tolerance relative tolerance on the mole fractions of key species
+		*@param absolute_tolerance absolute tolerance on the mole fractions of key species
+		*@param max_sets max number of stored sets of important species
+		*/
+		void SetReuse(	const unsigned int number_of_points, const double temperature_tolerance,
+				const double relative_tolerance, const double absolute_tolerance, const unsigned int max_sets);
+
+		/**
+		*@brief Resets the counters of full analyses and reuses
+		*/
+		void ResetStatistics();
+
+		/**
+		*@brief Returns the number of full analyses (since the last reset)
+		*/
+		unsigned int number_of_analyses() const { return number_of_analyses_; }
+
+		/**
+		*@brief Returns the number of reused sets of important species (since the last reset)
+		*/
+		unsigned int number_of_reuses() const { return number_of_reuses_; }
+
 		/**
 		*@brief Returns a boolean vector for each species: true means important (0-index based)
 		*/
@@ -85,6 +121,11 @@ namespace OpenSMOKE
 		*/
 		const std::vector<unsigned int>& indices_unimportant_reactions() const { return indices_unimportant_reactions_; }
 
+		/**
+		*@brief Returns the indices of important reactions (zero-based)
+		*/
+		const std::vector<unsigned int>& indices_important_reactions() const { return indices_important_reactions_; }
+
 		/**
 		*@brief Returns epsilon
 		*/
@@ -105,6 +146,16 @@ namespace OpenSMOKE
 		*/
 		void ParsePairWiseErrorMatrix();
 
+		/**
+		*@brief Updates the important reactions and the indices for the current important species
+		*/
+		void UpdateImportantReactions();
+
+		/**
+		*@brief Returns true if the current state is within the reuse tolerances from the reference state
+		*/
+		bool Close(const double T, const double T_ref, const double* x_ref) const;
+
 	private:
 
 		OpenSMOKE::ThermodynamicsMap_CHEMKIN& thermodynamicsMapXML_;	/**< reference to the thermodynamic map */
@@ -125,13 +176,40 @@ namespace OpenSMOKE
 		unsigned int number_unimportant_reactions_;				/**< number of unimportant reactions */
 
 		std::vector<unsigned int> indices_unimportant_reactions_;		/**< indices of unimportant reactions (zero-based) */
+		std::vector<unsigned int> indices_important_reactions_;			/**< indices of important reactions (zero-based) */
 		std::vector<unsigned int> indices_important_species_;			/**< indices of important species (zero-based) */
 
-		Eigen::MatrixXd					r_;			/**< full matrix, pair wise error matrix, (NS x NS) */
-		Eigen::SparseMatrix<double> 			nu_sparse_;		/**< sparse matrix containing the net stoichiometric coefficients, (NS x NR) */
-		std::vector< Eigen::SparseMatrix<double> >	nu_times_delta_;	/**< vector of sparse matrices (NS x NS) */
+		Eigen::SparseMatrix<double, Eigen::RowMajor>	r_;			/**< sparse pair wise error matrix, (NS x NS) */
 		Eigen::SparseMatrix<double> 			delta_sparse_;		/**< delta matrix (NS x NR) */
 
+		std::vector<unsigned int>	pairs_begin_;			/**< first (species, reaction) pair of each species, (NS+1) */
+		std::vector<unsigned int>	pairs_reaction_;		/**< reaction of each (species, reaction) pair (zero-based) */
+		std::vector<double>		pairs_nu_;			/**< absolute net stoichiometric coefficient of each pair */
+		std::vector<unsigned int>	pairs_positions_begin_;		/**< first position in pairs_positions_ of each pair */
+		std::vector<unsigned int>	pairs_positions_;		/**< positions in r_ of the species involved in the reaction of each pair */
+
+		bool reuse_;							/**< reuse of important species */
+		double reuse_temperature_tolerance_;				/**< max difference of temperature for reuse [K] */
+		double reuse_relative_tolerance_;				/**< relative tolerance on mole fractions of key species for reuse */
+		double reuse_absolute_tolerance_;				/**< absolute tolerance on mole fractions of key species for reuse */
+		unsigned int reuse_max_sets_;					/**< max number of stored sets of important species */
+
+		std::vector< std::vector<bool> > sets_;				/**< stored sets of important species */
+		std::vector<double> set_epsilon_;				/**< threshold used for each stored set */
+		int current_set_;						/**< stored set corresponding to the current important species (-1 if none) */
+
+		int last_set_;							/**< set of the last full analysis */
+		double last_T_;							/**< temperature of the last full analysis [K] */
+		std::vector<double> last_x_;					/**< mole fractions of key species of the last full analysis */
+
+		std::vector<int> point_set_;					/**< set used by each point (-1 if none) */
+		std::vector<double> point_T_;					/**< reference temperature of each point [K] */
+		std::vector<double> point_x_;					/**< reference mole fractions of key species of each point */
+		std::vector<double> x_;						/**< mole fractions of key species of the current point */
+
+		unsigned int number_of_analyses_;				/**< number of full analyses */
+		unsigned int number_of_reuses_;					/**< number of reuses */
+
 	};
 }
 
@@ -1,4 +1,5 @@
 #include <queue>
+#include <algorithm>
 
 namespace OpenSMOKE
 {
@@ -14,14 +15,15 @@ namespace OpenSMOKE
 		NR_ = kineticsMapXML_.NumberOfReactions();
 
 		ChangeDimensions(NR_, &rNet_, true);
-		r_.resize(NS_, NS_);
-		
 
 		important_species_.resize(NS_);
                 important_reactions_.resize(NR_);
 
 		number_important_species_ = NS_;
 		number_unimportant_reactions_ = 0;
+		indices_important_reactions_.resize(NR_);
+		for(unsigned int k = 0; k < NR_; k++)
+			indices_important_reactions_[k] = k;
 
 		// Build a full matrix of net stoichiometric coefficients nu = nuB - nuF
 		Eigen::MatrixXd nu_(NR_, NS_);						
@@ -67,23 +69,6 @@ namespace OpenSMOKE
 
 		// Sparse Algebra
 		{			
-			// Sparse net stoichiometric matrix
-			{
-				nu_sparse_.resize(NS_,NR_);
-
-				typedef Eigen::Triplet<double> T;
-				std::vector<T> tripletList;
-				tripletList.reserve(NR_*4);
-				for (unsigned int i = 0; i < NR_; i++)
-					for (unsigned int j = 0; j < NS_; j++)
-					{
-  						if ( nu_(i,j) != 0.)
-  						tripletList.push_back(T(j,i,nu_(i,j)));
-					}
-		
-				nu_sparse_.setFromTriplets(tripletList.begin(), tripletList.end());
-			}
-
 			// Sparse delta matrix, 1 means the species is involved in the reaction, (NR x NS)
 			delta_sparse_.resize(NS_,NR_);
 			{
@@ -100,29 +85,61 @@ namespace OpenSMOKE
 				delta_sparse_.setFromTriplets(tripletList.begin(), tripletList.end());
 			}
 
-			// Nu times delta
+			// Sparse pair-wise error matrix: rAB is non-zero only if A and B share at least one reaction
+			// For each species A and each reaction k involving A, the positions of the species of k
+			// in the row A of the pair-wise error matrix are stored
 			{
-				nu_times_delta_.resize(NS_);
+				std::vector< std::vector<unsigned int> > species_in_reaction(NR_);
+				for (unsigned int k = 0; k < NR_; k++)
+					for (unsigned int j = 0; j < NS_; j++)
+						if (delta_(k,j) != 0.)
+							species_in_reaction[k].push_back(j);
+
+				typedef Eigen::Triplet<double> T;
+				std::vector<T> tripletList;
+				for (unsigned int k = 0; k < NR_; k++)
+					for (unsigned int a = 0; a < species_in_reaction[k].size(); a++)
+						if (nu_(k, species_in_reaction[k][a]) != 0.)
+							for (unsigned int b = 0; b < species_in_reaction[k].size(); b++)
+								tripletList.push_back(T(species_in_reaction[k][a], species_in_reaction[k][b], 0.));
+
+				r_.resize(NS_, NS_);
+				r_.setFromTriplets(tripletList.begin(), tripletList.end());
+				r_.makeCompressed();
 
-				for (unsigned int k = 0; k < NS_; k++)
+				pairs_begin_.assign(NS_+1, 0);
+				for (unsigned int a = 0; a < NS_; a++)
 				{
-					nu_times_delta_[k].resize(NS_, NR_);
-
-					typedef Eigen::Triplet<double> T;
-					std::vector<T> tripletList;
-					tripletList.reserve(NR_*4);
-					for (unsigned int i = 0; i < NR_; i++)
-						for (unsigned int j = 0; j < NS_; j++)
-						{
-							const double prod = nu_(i,k) * delta_(i,j);
-  							if ( prod != 0.)
-  								tripletList.push_back(T(j,i, prod));
-						}
-		
-					nu_times_delta_[k].setFromTriplets(tripletList.begin(), tripletList.end());
+					for (unsigned int k = 0; k < NR_; k++)
+					{
+						if (nu_(k,a) == 0.)
+							continue;
+
+						pairs_reaction_.push_back(k);
+						pairs_nu_.push_back(std::fabs(nu_(k,a)));
+						pairs_positions_begin_.push_back(pairs_positions_.size());
+
+						const int* first = r_.innerIndexPtr() + r_.outerIndexPtr()[a];
+						const int* last  = r_.innerIndexPtr() + r_.outerIndexPtr()[a+1];
+						for (unsigned int b = 0; b < species_in_reaction[k].size(); b++)
+							pairs_positions_.push_back(std::lower_bound(first, last, int(species_in_reaction[k][b])) - r_.innerIndexPtr());
+					}
+					pairs_begin_[a+1] = pairs_reaction_.size();
 				}
+				pairs_positions_begin_.push_back(pairs_positions_.size());
 			}
 		}
+
+		// Reuse of important species
+		reuse_ = false;
+		reuse_temperature_tolerance_ = 10.;
+		reuse_relative_tolerance_ = 0.05;
+		reuse_absolute_tolerance_ = 1.e-6;
+		reuse_max_sets_ = 1000;
+		current_set_ = -1;
+		last_set_ = -1;
+		number_of_analyses_ = 0;
+		number_of_reuses_ = 0;
 	}
 
 	void DRG::SetKeySpecies(const std::vector<std::string> names_key_species)
@@ -142,10 +159,123 @@ namespace OpenSMOKE
 		epsilon_ = epsilon;
 	}
 
+	void DRG::SetReuse(	const unsigned int number_of_points, const double temperature_tolerance,
+				const double relative_tolerance, const double absolute_tolerance, const unsigned int max_sets)
+	{
+		reuse_ = true;
+		reuse_temperature_tolerance_ = temperature_tolerance;
+		reuse_relative_tolerance_ = relative_tolerance;
+		reuse_absolute_tolerance_ = absolute_tolerance;
+		reuse_max_sets_ = max_sets;
+
+		point_set_.assign(number_of_points, -1);
+		point_T_.assign(number_of_points, 0.);
+		point_x_.assign(number_of_points*index_key_species_.size(), 0.);
+		last_x_.assign(index_key_species_.size(), 0.);
+		x_.assign(index_key_species_.size(), 0.);
+	}
+
+	void DRG::ResetStatistics()
+	{
+		number_of_analyses_ = 0;
+		number_of_reuses_ = 0;
+	}
+
 	void DRG::Analysis(const double T, const double P_Pa, const OpenSMOKE::OpenSMOKEVectorDouble& c)
 	{
 		PairWiseErrorMatrix(T, P_Pa, c);
 		ParsePairWiseErrorMatrix();
+
+		current_set_ = -1;
+		number_of_analyses_++;
+	}
+
+	void DRG::Analysis(const unsigned int point, const double T, const double P_Pa, const OpenSMOKE::OpenSMOKEVectorDouble& c)
+	{
+		if (reuse_ == false)
+		{
+			Analysis(T, P_Pa, c);
+			return;
+		}
+
+		const unsigned int nk = index_key_species_.size();
+
+		// Mole fractions of key species
+		{
+			double cTot = 0.;
+			for (unsigned int i = 1; i <= NS_; i++)
+				cTot += c[i];
+			for (unsigned int i = 0; i < nk; i++)
+				x_[i] = c[index_key_species_[i]+1]/cTot;
+		}
+
+		// 1. Set used by the same point (previous time steps)
+		int candidate = -1;
+		if (point_set_[point] >= 0 && set_epsilon_[point_set_[point]] == epsilon_ && Close(T, point_T_[point], &point_x_[point*nk]) == true)
+		{
+			candidate = point_set_[point];
+		}
+
+		// 2. Set of the last analyzed point (neighbouring points)
+		else if (last_set_ >= 0 && set_epsilon_[last_set_] == epsilon_ && Close(T, last_T_, &last_x_[0]) == true)
+		{
+			candidate = last_set_;
+			point_set_[point] = last_set_;
+			point_T_[point] = last_T_;
+			for (unsigned int i = 0; i < nk; i++)
+				point_x_[point*nk+i] = last_x_[i];
+		}
+
+		if (candidate >= 0)
+		{
+			if (candidate != current_set_)
+			{
+				important_species_ = sets_[candidate];
+				UpdateImportantReactions();
+				current_set_ = candidate;
+			}
+
+			number_of_reuses_++;
+			return;
+		}
+
+		// Full analysis
+		PairWiseErrorMatrix(T, P_Pa, c);
+		ParsePairWiseErrorMatrix();
+		number_of_analyses_++;
+
+		// The stored sets are discarded when too many
+		if (sets_.size() >= reuse_max_sets_)
+		{
+			sets_.clear();
+			set_epsilon_.clear();
+			point_set_.assign(point_set_.size(), -1);
+		}
+
+		sets_.push_back(important_species_);
+		set_epsilon_.push_back(epsilon_);
+		current_set_ = sets_.size()-1;
+
+		last_set_ = current_set_;
+		last_T_ = T;
+		last_x_ = x_;
+
+		point_set_[point] = current_set_;
+		point_T_[point] = T;
+		for (unsigned int i = 0; i < nk; i++)
+			point_x_[point*nk+i] = x_[i];
+	}
+
+	bool DRG::Close(const double T, const double T_ref, const double* x_ref) const
+	{
+		if (std::fabs(T-T_ref) > reuse_temperature_tolerance_)
+			return false;
+
+		for (unsigned int i = 0; i < x_.size(); i++)
+			if (std::fabs(x_[i]-x_ref[i]) > reuse_relative_tolerance_*std::fabs(x_ref[i]) + reuse_absolute_tolerance_)
+				return false;
+
+		return true;
 	}
 
 	void DRG::PairWiseErrorMatrix(const double T, const double P_Pa, const OpenSMOKE::OpenSMOKEVectorDouble& c)
@@ -161,48 +291,36 @@ namespace OpenSMOKE
 		kineticsMapXML_.ReactionRates(c.GetHandle());
 		kineticsMapXML_.GiveMeReactionRates(rNet_.GetHandle());	// [kmol/m3/s]
 
-		// Calculate the pair-wise error matrix
-		r_.setZero();
+		// Calculate the pair-wise error matrix (only the non-zero elements)
 		{
-			Eigen::VectorXd numerator_(NS_);
-			Eigen::VectorXd denominator_(NS_);
+			double* values = r_.valuePtr();
+			const int* outer = r_.outerIndexPtr();
 
-			// Denominator			
-			denominator_.setConstant(0.);		
-			for (int k=0; k<nu_sparse_.outerSize(); ++k)
-  			{
-				const double rnet = rNet_[k+1];
-				for (Eigen::SparseMatrix<double>::InnerIterator it(nu_sparse_,k); it; ++it)
-  				{
-    					denominator_[it.row()] += std::fabs(it.value() * rnet);
-  				}
-			}
-
-			// Numerator
-			for (int i = 0; i < NS_; i++)
+			for (unsigned int a = 0; a < NS_; a++)
 			{
-				numerator_.setConstant(0.);
-				for (int k=0; k<nu_times_delta_[i].outerSize(); ++k)
-  				{
-					const double rnet = rNet_[k+1];
-					for (Eigen::SparseMatrix<double>::InnerIterator it(nu_times_delta_[i],k); it; ++it)
-  					{
-    						numerator_[it.row()] += std::fabs(it.value() * rnet);
-  					}
+				for (int p = outer[a]; p < outer[a+1]; p++)
+					values[p] = 0.;
+
+				double denominator = 0.;
+				for (unsigned int t = pairs_begin_[a]; t < pairs_begin_[a+1]; t++)
+				{
+					const double contribution = pairs_nu_[t]*std::fabs(rNet_[pairs_reaction_[t]+1]);
+					denominator += contribution;
+
+					for (unsigned int p = pairs_positions_begin_[t]; p < pairs_positions_begin_[t+1]; p++)
+						values[pairs_positions_[p]] += contribution;
 				}
 
-				for (int j = 0; j < NS_; j++)
-					r_(i,j) = numerator_[j]/(1.e-64+denominator_[i]);
+				for (int p = outer[a]; p < outer[a+1]; p++)
+					values[p] /= (1.e-64+denominator);
 			}
-			
 		}
         }
         
 	void DRG::ParsePairWiseErrorMatrix()
 	{
-		// Reset important species and important reactions
+		// Reset important species
 		important_species_.assign(NS_,false);
-		important_reactions_.assign(NR_,true);
      
 		// Initialize the queue with key-species
 		std::queue <int> Q;
@@ -212,14 +330,15 @@ namespace OpenSMOKE
 			important_species_[index_key_species_[i]]=true;
 		}
            
-		// DFS with rAB
+		// DFS with rAB (only the species sharing at least one reaction with the current species)
 		while (!Q.empty())
 		{
-			for ( int k=0; k<NS_; k++)
+			for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(r_, Q.front()); it; ++it)
 			{
+				const int k = it.col();
 				if (important_species_[k] == false)                    
 				{
-					if (r_(Q.front(), k) > epsilon_)
+					if (it.value() > epsilon_)
 					{                            
 						important_species_[k] = true;
 						Q.push(k);
@@ -228,6 +347,14 @@ namespace OpenSMOKE
 			}
 			Q.pop();
 		}	
+
+		UpdateImportantReactions();
+	}
+
+	void DRG::UpdateImportantReactions()
+	{
+		// Reset important reactions
+		important_reactions_.assign(NR_,true);
                 
 		// Important reactions
 		for (int k=0; k<delta_sparse_.outerSize(); ++k)
@@ -257,16 +384,23 @@ namespace OpenSMOKE
 				}
                 }
 
-		// Vector containing the indices of unimportant species (zero-based)
+		// Vectors containing the indices of unimportant and important reactions (zero-based)
 		{
 			indices_unimportant_reactions_.resize(number_unimportant_reactions_);
+			indices_important_reactions_.resize(NR_-number_unimportant_reactions_);
 			unsigned int count = 0;
+			unsigned int count_important = 0;
 			for(unsigned int k = 0; k < NR_; k++)
 				if (important_reactions_[k] == false)
 				{
 					indices_unimportant_reactions_[count] = k;
 					count++;
 				}
+				else
+				{
+					indices_important_reactions_[count_important] = k;
+					count_important++;
+				}
                 }
 			
 	}
@@ -530,14 +530,16 @@ namespace OpenSMOKE
 		}
 
 		// Jacobian matrix (version diagonal)
+		// Only the reactions involving the k-th species are touched (and then reset), so that the cost
+		// is proportional to the number of non-zero elements and not to the number of reactions
 		Jdiagonal.setConstant(0.);
 		Eigen::VectorXd net_reaction_rates(nr);
+		net_reaction_rates.setConstant(0.);
 		{
 			for (int k = 0; k < nc; ++k)
 			{
-				net_reaction_rates.setConstant(0.);
 				for (Eigen::SparseMatrix<double>::InnerIterator it(*drf_over_domega_, k); it; ++it)
-					net_reaction_rates(it.row()) = it.value();
+					net_reaction_rates(it.row()) += it.value();
 				for (Eigen::SparseMatrix<double>::InnerIterator it(*drb_over_domega_, k); it; ++it)
 					net_reaction_rates(it.row()) -= it.value();
 
@@ -552,6 +554,17 @@ namespace OpenSMOKE
 					Jdiagonal(k) -= it.value() * net_reaction_rates(it.row());
 				for (Eigen::SparseMatrix<double>::InnerIterator it(kinetics_map_.stoichiometry().stoichiometric_matrix_products(), k); it; ++it)
 					Jdiagonal(k) += it.value() * net_reaction_rates(it.row());
+
+				for (Eigen::SparseMatrix<double>::InnerIterator it(*drf_over_domega_, k); it; ++it)
+					net_reaction_rates(it.row()) = 0.;
+				for (Eigen::SparseMatrix<double>::InnerIterator it(*drb_over_domega_, k); it; ++it)
+					net_reaction_rates(it.row()) = 0.;
+				for (Eigen::SparseMatrix<double>::InnerIterator it(*dthirdbody_over_domega_, k); it; ++it)
+					net_reaction_rates(it.row()) = 0.;
+				for (Eigen::SparseMatrix<double>::InnerIterator it(*dfalloff_over_domega_, k); it; ++it)
+					net_reaction_rates(it.row()) = 0.;
+				for (Eigen::SparseMatrix<double>::InnerIterator it(*dcabr_over_domega_, k); it; ++it)
+					net_reaction_rates(it.row()) = 0.;
 			}
 		}
 	}
@@ -44,6 +44,7 @@
 #include "StoichiometricMap.h"
 #include "JacobianSparsityPatternMap.h"
 #include "rapidxml.hpp"
+#include <boost/shared_ptr.hpp>
 
 namespace OpenSMOKE
 {
@@ -206,6 +207,50 @@ namespace OpenSMOKE
 		*/
 		void ReactionRates(const double* c, const double cTot);
 
+		/**
+		*@brief Restricts the evaluation of reaction rates to a subset of reactions (active reactions), for example
+				the important reactions of a reduced mechanism. The compacted lists of active reactions are built
+				only if the subset is changed with respect to the previous call.
+		*@param indices indices of active reactions (zero-based)
+		*/
+		void SetActiveReactions(const std::vector<unsigned int>& indices);
+
+		/**
+		*@brief Calculates the reaction rates of the active reactions only, with a cost proportional to their number.
+				The kinetic constants are calculated directly (the table of kinetic constants, if any, is not used).
+				The net reaction rates of the other reactions are set equal to zero at every call.
+		*@param c concentrations of species (in kmol/m3)
+		*@param cTot total concentration (in kmol/m3)
+		*/
+		void ReactionRatesOfActiveReactions(const double* c, const double cTot);
+
+		/**
+		*@brief Calculates the formation rates of species from the reaction rates of the active reactions only [kmol/m3/s]
+		*/
+		void FormationRatesOfActiveReactions(double* R);
+
+		/**
+		*@brief Calculates the reaction rates for a block of thermodynamic states (e.g. computational cells).
+				The data are organized as structure of arrays: the value of the i-th species (or reaction)
+				in the p-th state is stored in position i*n+p, so that the innermost loops run over the states
+				and can be vectorized by the compiler. Please note that the temperature and pressure
+				of the thermodynamic map are modified by this function.
+		*@param n number of states
+		*@param T temperatures (in K)
+		*@param P pressures (in Pa)
+		*@param c concentrations of species (in kmol/m3), NS*n values
+		*@param r net reaction rates (in kmol/m3/s), NR*n values
+		*/
+		void ReactionRates(const unsigned int n, const double* T, const double* P, const double* c, double* r);
+
+		/**
+		*@brief Calculates the formation rates for a block of thermodynamic states
+		*@param n number of states
+		*@param r net reaction rates (in kmol/m3/s), NR*n values (structure of arrays)
+		*@param R formation rates (in kmol/m3/s), NS*n values (structure of arrays)
+		*/
+		void FormationRates(const unsigned int n, const double* r, double* R);
+
 		/**
 		*@brief Returns the indices of the reversible reactions
 		*/
@@ -221,6 +266,23 @@ namespace OpenSMOKE
 		*/
 		void KineticConstants();
 
+		/**
+		*@brief Builds a table of the kinetic parameters depending only on the temperature (Arrhenius constants,
+				inverse equilibrium constants, high-pressure limits and broadening factors of fall-off and cabr reactions).
+				Inside the table range the kinetic constants are then obtained by linear interpolation, without
+				evaluating exponential and logarithmic functions. Outside the table range they are calculated as usual.
+		*@param Tmin minimum temperature of the table (in K)
+		*@param Tmax maximum temperature of the table (in K)
+		*@param deltaT temperature step of the table (in K)
+		*@return the maximum relative error of the interpolated kinetic constants (estimated at the midpoints of the grid)
+		*/
+		double TabulateKineticConstants(const double Tmin, const double Tmax, const double deltaT);
+
+		/**
+		*@brief Returns true if the kinetic constants are tabulated
+		*/
+		bool IsKineticConstantsTableAvailable() const { return kinetic_constants_table_available_; }
+
 		/**
 		*@brief Return the frequency factor of a single reaction [kmol, m, s]
 		*@param j index of reaction (starting from zero)
@@ -348,6 +410,22 @@ namespace OpenSMOKE
 		*/
 		void DerivativesOfFormationRates(const double* c, const double* omega, Eigen::MatrixXd* dR_over_domega);
 
+		/**
+		*@brief Calculates the derivatives of formation rates with respect to concentrations at fixed total concentration,
+		*       exploiting the sparsity of the kinetic mechanism: species which do not share any reaction are perturbed
+		*       together, so that the number of evaluations of reaction rates is equal to the number of groups of species
+		*       and not to the number of species. Temperature and pressure must be already set.
+		*@param cTot total concentration (in kmol/m3), kept constant during the perturbations
+		*@param c current concentrations (in kmol/m3)
+		*@param dR_over_dC the calculated derivatives (in 1/s), stored according to the sparsity pattern of the mechanism
+		*/
+		void DerivativesOfFormationRates(const double cTot, const double* c, Eigen::SparseMatrix<double>* dR_over_dC);
+
+		/**
+		*@brief Returns the number of groups of species perturbed together for calculating the sparse derivatives of formation rates
+		*/
+		unsigned int NumberOfSparseDerivativesGroups();
+
 		/**
 		*@brief Returns the stoichiometric map
 		*/
@@ -423,6 +501,17 @@ namespace OpenSMOKE
 
 	private:
 
+		/**
+		*@brief Calculates the kinetic constants of the active reactions only
+		*/
+		void KineticConstantsOfActiveReactions();
+
+		/**
+		*@brief Returns the correction due to the chemically activated bimolecular effects for a given cabr reaction
+		*@param local_k index of reaction (among the cabr reactions)
+		*/
+		double ChemicallyActivatedBimolecularReactionsCorrection(const unsigned int local_k, const double cTot, const double* c);
+
 		/**
 		*@brief Calculates the efficiencies for threebody reactions
 		*/
@@ -453,6 +542,22 @@ namespace OpenSMOKE
 		*/
 		void CopyFromMap(const KineticsMap_CHEMKIN& rhs);
 
+		/**
+		*@brief Interpolates the kinetic parameters from the table at the current temperature
+		*/
+		void InterpolateKineticConstants();
+
+		/**
+		*@brief Copies the current (temperature dependent) kinetic parameters in a row of the table
+		*/
+		void KineticConstantsToRow(double* row) const;
+
+		/**
+		*@brief Builds the sparsity pattern of derivatives of formation rates with respect to concentrations
+		*       and the groups of species which can be perturbed together (column compression)
+		*/
+		void SparseDerivativesPattern();
+
 	private:
 
 		// TODO
@@ -566,6 +671,35 @@ namespace OpenSMOKE
 		bool reaction_h_and_s_must_be_recalculated_;
 		bool isJacobianSparsityMapAvailable_;
 
+		bool active_kinetic_constants_must_be_recalculated_;	//!< true if the kinetic constants of active reactions must be recalculated
+		std::vector<unsigned int> active_reactions__;				//!< active reactions (0-based)
+		std::vector<unsigned int> active_thirdbody_reactions__;			//!< active threebody reactions (local index, 0-based)
+		std::vector<unsigned int> active_falloff_reactions__;			//!< active falloff reactions (local index, 0-based)
+		std::vector<unsigned int> active_cabr_reactions__;			//!< active cabr reactions (local index, 0-based)
+		std::vector<unsigned int> active_chebyshev_reactions__;			//!< active Chebyshev reactions (local index, 0-based)
+		std::vector<unsigned int> active_pressurelog_reactions__;		//!< active PLOG reactions (local index, 0-based)
+		std::vector<unsigned int> active_extendedpressurelog_reactions__;	//!< active extended PLOG reactions (local index, 0-based)
+		std::vector<unsigned int> active_extendedfalloff_reactions__;		//!< active extended falloff reactions (local index, 0-based)
+		std::vector<unsigned int> active_thermodynamic_reversible_reactions__;	//!< active thermodynamically reversible reactions (local index, 0-based)
+		std::vector<unsigned int> active_explicitly_reversible_reactions__;	//!< active explicitly reversible reactions (local index, 0-based)
+		std::vector<unsigned int> active_reversible_reactions__;		//!< active reversible reactions (0-based)
+		std::vector<unsigned int> active_negative_lnA__;			//!< active reactions with negative frequency factor (0-based)
+
+		bool kinetic_constants_table_available_;		//!< true if the kinetic constants are tabulated
+		double kinetic_constants_table_Tmin_;			//!< minimum temperature of the table (in K)
+		double kinetic_constants_table_Tmax_;			//!< maximum temperature of the table (in K)
+		double kinetic_constants_table_deltaT_;			//!< temperature step of the table (in K)
+		unsigned int kinetic_constants_table_columns_;		//!< number of kinetic parameters stored for each temperature
+		boost::shared_ptr<const std::vector<double> > kinetic_constants_table__;	//!< table of kinetic parameters (one row for each temperature), shared read-only by the copies of the map
+
+		bool sparse_derivatives_available_;					//!< true if the sparsity pattern of derivatives is available
+		Eigen::SparseMatrix<double> sparse_derivatives_pattern_;		//!< sparsity pattern of derivatives of formation rates
+		std::vector< std::vector<unsigned int> > sparse_derivatives_groups__;	//!< groups of species perturbed together (0-based)
+		std::vector<double> sparse_derivatives_c__;				//!< perturbed concentrations (in kmol/m3)
+		std::vector<double> sparse_derivatives_dc__;				//!< perturbations of concentrations (in kmol/m3)
+		std::vector<double> sparse_derivatives_R__;				//!< unperturbed formation rates (in kmol/m3/s)
+		std::vector<double> sparse_derivatives_Rplus__;				//!< perturbed formation rates (in kmol/m3/s)
+
 		std::vector<double> reaction_s_over_R__;
 		std::vector<double> reaction_h_over_RT__;
 		std::vector<double> kArrheniusModified__;
@@ -585,6 +719,28 @@ namespace OpenSMOKE
 		std::vector<double> correction_falloff__;						//!< correction factors for the falloff reactions
 		std::vector<double> correction_cabr__;							//!< correction factors for the cabr reactions
 
+		std::vector<double> batch_logT__;						//!< logarithm of temperature (block of states)
+		std::vector<double> batch_uT__;							//!< inverse of temperature (block of states)
+		std::vector<double> batch_cTot__;						//!< total concentration (block of states)
+		std::vector<double> batch_log_Patm_over_RT__;					//!< logarithm of Patm/RT (block of states)
+		std::vector<double> batch_reaction_h_over_RT__;					//!< reaction enthalpies (block of states)
+		std::vector<double> batch_reaction_s_over_R__;					//!< reaction entropies (block of states)
+		std::vector<double> batch_kArrhenius__;						//!< Arrhenius kinetic constants (block of states)
+		std::vector<double> batch_kArrheniusModified__;					//!< effective kinetic constants (block of states)
+		std::vector<double> batch_uKeq__;						//!< inverse equilibrium constants (block of states)
+		std::vector<double> batch_kArrhenius_reversible__;				//!< explicit reverse kinetic constants (block of states)
+		std::vector<double> batch_kArrhenius_falloff_inf__;				//!< high-pressure falloff kinetic constants (block of states)
+		std::vector<double> batch_logFcent_falloff__;					//!< falloff broadening parameters (block of states)
+		std::vector<double> batch_kArrhenius_cabr_inf__;				//!< high-pressure cabr kinetic constants (block of states)
+		std::vector<double> batch_logFcent_cabr__;					//!< cabr broadening parameters (block of states)
+		std::vector<double> batch_forwardReactionRates__;				//!< product of concentrations, forward (block of states)
+		std::vector<double> batch_reverseReactionRates__;				//!< product of concentrations, reverse (block of states)
+		std::vector<double> batch_M__;							//!< third-body concentrations (block of states)
+		std::vector<double> batch_cell_c__;						//!< auxiliary vector (single state, species)
+		std::vector<double> batch_cell_R__;						//!< auxiliary vector (single state, species)
+		std::vector<double> batch_cell_a__;						//!< auxiliary vector (single state, reactions)
+		std::vector<double> batch_cell_b__;						//!< auxiliary vector (single state, reactions)
+
 		ChebyshevPolynomialRateExpression* chebyshev_reactions_;				//!< pointer to the list of Chebyshev reactions
 		PressureLogarithmicRateExpression* pressurelog_reactions_;				//!< pointer to the list of PLOG reactions
 		ExtendedPressureLogarithmicRateExpression* extendedpressurelog_reactions_;		//!< pointer to the list of PLOGMX/PLOGSP reactions
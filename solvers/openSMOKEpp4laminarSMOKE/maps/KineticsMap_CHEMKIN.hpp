@@ -46,6 +46,9 @@ namespace OpenSMOKE
 		this->number_of_points_ = nPoints;
         this->verbose_output_ = true;
         this->isJacobianSparsityMapAvailable_ = false;
+        this->kinetic_constants_table_available_ = false;
+        this->sparse_derivatives_available_ = false;
+        this->active_kinetic_constants_must_be_recalculated_ = true;
                 
 		this->T_ = this->P_ = 0.;
 	}
@@ -57,6 +60,9 @@ namespace OpenSMOKE
                 
         this->verbose_output_ = true;
         this->isJacobianSparsityMapAvailable_ = false;
+        this->kinetic_constants_table_available_ = false;
+        this->sparse_derivatives_available_ = false;
+        this->active_kinetic_constants_must_be_recalculated_ = true;
                 
 		ImportSpeciesFromXMLFile(doc);
 		ImportCoefficientsFromXMLFile(doc);
@@ -70,6 +76,9 @@ namespace OpenSMOKE
                 
         this->verbose_output_ = verbose;
         this->isJacobianSparsityMapAvailable_ = false;
+        this->kinetic_constants_table_available_ = false;
+        this->sparse_derivatives_available_ = false;
+        this->active_kinetic_constants_must_be_recalculated_ = true;
                 
 		ImportSpeciesFromXMLFile(doc);
 		ImportCoefficientsFromXMLFile(doc);
@@ -195,6 +204,18 @@ namespace OpenSMOKE
         this->reaction_h_and_s_must_be_recalculated_ = true;
         this->isJacobianSparsityMapAvailable_ = false;
 
+        this->kinetic_constants_table_available_ = rhs.kinetic_constants_table_available_;
+        this->kinetic_constants_table_Tmin_ = rhs.kinetic_constants_table_Tmin_;
+        this->kinetic_constants_table_Tmax_ = rhs.kinetic_constants_table_Tmax_;
+        this->kinetic_constants_table_deltaT_ = rhs.kinetic_constants_table_deltaT_;
+        this->kinetic_constants_table_columns_ = rhs.kinetic_constants_table_columns_;
+        this->kinetic_constants_table__ = rhs.kinetic_constants_table__;
+
+        this->sparse_derivatives_available_ = false;
+
+        this->active_kinetic_constants_must_be_recalculated_ = true;
+        this->active_reactions__.clear();
+
 		reaction_s_over_R__.resize(rhs.reaction_s_over_R__.size());
 		reaction_h_over_RT__.resize(rhs.reaction_h_over_RT__.size());
 		kArrheniusModified__.resize(rhs.kArrheniusModified__.size());
@@ -283,6 +304,7 @@ namespace OpenSMOKE
 			arrhenius_kinetic_constants_must_be_recalculated_ = true;
 			nonconventional_kinetic_constants_must_be_recalculated_ = true;
 			reaction_h_and_s_must_be_recalculated_ = true;
+			active_kinetic_constants_must_be_recalculated_ = true;
 		}
 	}
 
@@ -1191,7 +1213,20 @@ namespace OpenSMOKE
 
 	void KineticsMap_CHEMKIN::KineticConstants()
 	{
-        ReactionEnthalpiesAndEntropies();
+		// Tabulated kinetic constants (the reaction enthalpies and entropies are not needed)
+		if (	kinetic_constants_table_available_ == true &&
+			this->T_ >= kinetic_constants_table_Tmin_ && this->T_ < kinetic_constants_table_Tmax_ )
+		{
+			if (arrhenius_kinetic_constants_must_be_recalculated_ == true)
+			{
+				InterpolateKineticConstants();
+				arrhenius_kinetic_constants_must_be_recalculated_ = false;
+			}
+		}
+		else
+		{
+			ReactionEnthalpiesAndEntropies();
+		}
                 
 		if (arrhenius_kinetic_constants_must_be_recalculated_ == true)
 		{
@@ -1385,6 +1420,176 @@ namespace OpenSMOKE
 		kArrheniusModified__ = kArrhenius__;
 	}
 
+	void KineticsMap_CHEMKIN::KineticConstantsToRow(double* row) const
+	{
+		row = std::copy(kArrhenius__.begin(), kArrhenius__.end(), row);
+		row = std::copy(uKeq__.begin(), uKeq__.end(), row);
+		row = std::copy(kArrhenius_reversible__.begin(), kArrhenius_reversible__.end(), row);
+		row = std::copy(kArrhenius_falloff_inf__.begin(), kArrhenius_falloff_inf__.end(), row);
+		row = std::copy(kArrhenius_cabr_inf__.begin(), kArrhenius_cabr_inf__.end(), row);
+		row = std::copy(logFcent_falloff__.begin(), logFcent_falloff__.end(), row);
+		row = std::copy(logFcent_cabr__.begin(), logFcent_cabr__.end(), row);
+	}
+
+	void KineticsMap_CHEMKIN::InterpolateKineticConstants()
+	{
+		// The interval index is clamped, since round-off can give the last grid point for T just below Tmax
+		const unsigned int np = static_cast<unsigned int>(kinetic_constants_table__->size() / kinetic_constants_table_columns_);
+		const double x = (this->T_ - kinetic_constants_table_Tmin_) / kinetic_constants_table_deltaT_;
+		const unsigned int i = std::min(static_cast<unsigned int>(x), np-2);
+		const double w = x - static_cast<double>(i);
+
+		const double* a = &(*kinetic_constants_table__)[i*kinetic_constants_table_columns_];
+		const double* b = a + kinetic_constants_table_columns_;
+
+		double* pt = kArrhenius__.data();
+		for (unsigned int j = 0; j < kArrhenius__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+		a += kArrhenius__.size(); b += kArrhenius__.size();
+
+		pt = uKeq__.data();
+		for (unsigned int j = 0; j < uKeq__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+		a += uKeq__.size(); b += uKeq__.size();
+
+		pt = kArrhenius_reversible__.data();
+		for (unsigned int j = 0; j < kArrhenius_reversible__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+		a += kArrhenius_reversible__.size(); b += kArrhenius_reversible__.size();
+
+		pt = kArrhenius_falloff_inf__.data();
+		for (unsigned int j = 0; j < kArrhenius_falloff_inf__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+		a += kArrhenius_falloff_inf__.size(); b += kArrhenius_falloff_inf__.size();
+
+		pt = kArrhenius_cabr_inf__.data();
+		for (unsigned int j = 0; j < kArrhenius_cabr_inf__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+		a += kArrhenius_cabr_inf__.size(); b += kArrhenius_cabr_inf__.size();
+
+		pt = logFcent_falloff__.data();
+		for (unsigned int j = 0; j < logFcent_falloff__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+		a += logFcent_falloff__.size(); b += logFcent_falloff__.size();
+
+		pt = logFcent_cabr__.data();
+		for (unsigned int j = 0; j < logFcent_cabr__.size(); j++)
+			pt[j] = a[j] + w*(b[j] - a[j]);
+	}
+
+	double KineticsMap_CHEMKIN::TabulateKineticConstants(const double Tmin, const double Tmax, const double deltaT)
+	{
+		if (Tmin <= 0. || Tmax <= Tmin || deltaT <= 0.)
+		{
+			std::cout << "Error in the tabulation of kinetic constants: wrong temperature range or step" << std::endl;
+			exit(OPENSMOKE_FATAL_ERROR_EXIT);
+		}
+
+		const double T_backup = this->T_;
+		const double P_backup = this->P_;
+		if (this->P_ <= 0.)
+			SetPressure(101325.);
+
+		const unsigned int np = static_cast<unsigned int>((Tmax - Tmin) / deltaT + 0.5) + 1;
+
+		kinetic_constants_table_available_ = false;
+		kinetic_constants_table_Tmin_ = Tmin;
+		kinetic_constants_table_deltaT_ = deltaT;
+		kinetic_constants_table_Tmax_ = Tmin + (np - 1)*deltaT;
+		kinetic_constants_table_columns_ =	static_cast<unsigned int>(	kArrhenius__.size() + uKeq__.size() + kArrhenius_reversible__.size() +
+											kArrhenius_falloff_inf__.size() + kArrhenius_cabr_inf__.size() +
+											logFcent_falloff__.size() + logFcent_cabr__.size() );
+
+		// Table (a new table is built, since the previous one could be shared with copies of the map)
+		boost::shared_ptr<std::vector<double> > table(new std::vector<double>(np*kinetic_constants_table_columns_));
+		for (unsigned int i = 0; i < np; i++)
+		{
+			const double T = kinetic_constants_table_Tmin_ + i*deltaT;
+			thermodynamics_.SetTemperature(T);
+			SetTemperature(T);
+			KineticConstants();
+			KineticConstantsToRow(&(*table)[i*kinetic_constants_table_columns_]);
+		}
+		kinetic_constants_table__ = table;
+
+		// Error estimation (midpoints of the temperature grid, where the interpolation error is largest)
+		// Troe: the relative error on the broadening factor is bounded by ln(10) times the error on log10(Fcent)
+		// SRI: the relative error on the broadening factor is bounded by the relative error on the tabulated term
+		std::vector<double> exact(kinetic_constants_table_columns_);
+		std::vector<double> interpolated(kinetic_constants_table_columns_);
+
+		const unsigned int NK =	static_cast<unsigned int>(	kArrhenius__.size() + uKeq__.size() + kArrhenius_reversible__.size() + 
+								kArrhenius_falloff_inf__.size() + kArrhenius_cabr_inf__.size() );
+
+		double max_error = 0.;
+		double T_max_error = Tmin;
+		for (unsigned int i = 0; i < np-1; i++)
+		{
+			const double T = kinetic_constants_table_Tmin_ + (i + 0.5)*deltaT;
+
+			thermodynamics_.SetTemperature(T);
+			SetTemperature(T);
+			KineticConstants();
+			KineticConstantsToRow(exact.data());
+
+			InterpolateKineticConstants();
+			KineticConstantsToRow(interpolated.data());
+
+			for (unsigned int j = 0; j < kinetic_constants_table_columns_; j++)
+			{
+				double error = 0.;
+
+				if (j < NK)
+				{
+					if (exact[j] != 0.)
+						error = std::fabs(interpolated[j] - exact[j]) / std::fabs(exact[j]);
+				}
+				else
+				{
+					const unsigned int k = j - NK;
+					const PhysicalConstants::TAG_REACTION type = (k < number_of_falloff_reactions_) ?
+						falloff_reaction_type__[k] : cabr_reaction_type__[k - number_of_falloff_reactions_];
+
+					if (type == PhysicalConstants::REACTION_TROE_FALLOFF || type == PhysicalConstants::REACTION_TROE_CABR)
+						error = std::log(10.) * std::fabs(interpolated[j] - exact[j]);
+					else if (type == PhysicalConstants::REACTION_SRI_FALLOFF || type == PhysicalConstants::REACTION_SRI_CABR)
+						error = std::fabs(interpolated[j] - exact[j]) / std::fabs(exact[j]);
+				}
+
+				if (error > max_error)
+				{
+					max_error = error;
+					T_max_error = T;
+				}
+			}
+		}
+
+		kinetic_constants_table_available_ = true;
+
+		// Restore the original conditions
+		this->P_ = P_backup;
+		if (T_backup > 0.)
+		{
+			thermodynamics_.SetTemperature(T_backup);
+			SetTemperature(T_backup);
+		}
+		arrhenius_kinetic_constants_must_be_recalculated_ = true;
+		nonconventional_kinetic_constants_must_be_recalculated_ = true;
+		reaction_h_and_s_must_be_recalculated_ = true;
+
+		if (verbose_output_ == true)
+		{
+			std::cout << " * Tabulation of kinetic constants..." << std::endl;
+			std::cout << "   temperature range:         " << kinetic_constants_table_Tmin_ << " - " << kinetic_constants_table_Tmax_ << " K" << std::endl;
+			std::cout << "   temperature step:          " << kinetic_constants_table_deltaT_ << " K" << std::endl;
+			std::cout << "   number of points:          " << np << std::endl;
+			std::cout << "   memory:                    " << kinetic_constants_table__->size()*sizeof(double)/1024./1024. << " MB" << std::endl;
+			std::cout << "   max relative error:        " << max_error << " (at " << T_max_error << " K)" << std::endl;
+		}
+
+		return max_error;
+	}
+
 	void KineticsMap_CHEMKIN::ThirdBodyReactions(const double cTot, const double* c)
 	{	
 		for(unsigned int s=0;s<number_of_thirdbody_reactions_;s++)
@@ -1767,6 +1972,726 @@ namespace OpenSMOKE
 			netReactionRates__[i] *= kArrheniusModified__[i];
 	}
 
+	void KineticsMap_CHEMKIN::SetActiveReactions(const std::vector<unsigned int>& indices)
+	{
+		if (indices == active_reactions__)
+			return;
+
+		active_reactions__ = indices;
+
+		std::vector<bool> is_active(this->number_of_reactions_, false);
+		for (unsigned int i = 0; i < indices.size(); i++)
+			is_active[indices[i]] = true;
+
+		// Compacted lists (local indices, 0-based)
+		active_thirdbody_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_thirdbody_reactions_; k++)
+			if (is_active[indices_of_thirdbody_reactions__[k]-1] == true)	active_thirdbody_reactions__.push_back(k);
+
+		active_falloff_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_falloff_reactions_; k++)
+			if (is_active[indices_of_falloff_reactions__[k]-1] == true)	active_falloff_reactions__.push_back(k);
+
+		active_cabr_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_cabr_reactions_; k++)
+			if (is_active[indices_of_cabr_reactions__[k]-1] == true)	active_cabr_reactions__.push_back(k);
+
+		active_chebyshev_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_chebyshev_reactions_; k++)
+			if (is_active[indices_of_chebyshev_reactions__[k]-1] == true)	active_chebyshev_reactions__.push_back(k);
+
+		active_pressurelog_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_pressurelog_reactions_; k++)
+			if (is_active[indices_of_pressurelog_reactions__[k]-1] == true)	active_pressurelog_reactions__.push_back(k);
+
+		active_extendedpressurelog_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_extendedpressurelog_reactions_; k++)
+			if (is_active[indices_of_extendedpressurelog_reactions__[k]-1] == true)	active_extendedpressurelog_reactions__.push_back(k);
+
+		active_extendedfalloff_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_extendedfalloff_reactions_; k++)
+			if (is_active[indices_of_extendedfalloff_reactions__[k]-1] == true)	active_extendedfalloff_reactions__.push_back(k);
+
+		active_thermodynamic_reversible_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_thermodynamic_reversible_reactions_; k++)
+			if (is_active[indices_of_thermodynamic_reversible_reactions__[k]-1] == true)	active_thermodynamic_reversible_reactions__.push_back(k);
+
+		active_explicitly_reversible_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_explicitly_reversible_reactions_; k++)
+			if (is_active[indices_of_explicitly_reversible_reactions__[k]-1] == true)	active_explicitly_reversible_reactions__.push_back(k);
+
+		// Compacted lists (global indices, 0-based)
+		active_reversible_reactions__.clear();
+		for (unsigned int k = 0; k < number_of_reversible_reactions_; k++)
+			if (is_active[indices_of_reversible_reactions__[k]-1] == true)	active_reversible_reactions__.push_back(indices_of_reversible_reactions__[k]-1);
+
+		active_negative_lnA__.clear();
+		for (unsigned int k = 0; k < negative_lnA__.size(); k++)
+			if (is_active[negative_lnA__[k]-1] == true)	active_negative_lnA__.push_back(negative_lnA__[k]-1);
+
+		// Compacted stoichiometry
+		stoichiometry_->SetActiveReactions(indices);
+
+		active_kinetic_constants_must_be_recalculated_ = true;
+	}
+
+	void KineticsMap_CHEMKIN::KineticConstantsOfActiveReactions()
+	{
+		if (active_kinetic_constants_must_be_recalculated_ == true)
+		{
+			// Forward kinetic constants (Arrhenius' Law)
+			for (unsigned int i = 0; i < active_reactions__.size(); i++)
+			{
+				const unsigned int j = active_reactions__[i];
+				kArrhenius__[j] = std::exp(lnA__[j] + Beta__[j]*this->logT_ - E_over_R__[j]*this->uT_);
+			}
+
+			// Negative frequency factors: reactions must be reversed
+			for (unsigned int i = 0; i < active_negative_lnA__.size(); i++)
+				kArrhenius__[active_negative_lnA__[i]] *= -1.;
+
+			// Equilibrium constants (inverse value)
+			if (active_thermodynamic_reversible_reactions__.size() != 0)
+			{
+				stoichiometry_->ReactionEnthalpyAndEntropyOfActiveReactions(	reaction_h_over_RT__, reaction_s_over_R__,
+																thermodynamics_.Species_H_over_RT(), thermodynamics_.Species_S_over_R() );
+
+				for (unsigned int i = 0; i < active_thermodynamic_reversible_reactions__.size(); i++)
+				{
+					const unsigned int k = active_thermodynamic_reversible_reactions__[i];
+					const unsigned int j = indices_of_thermodynamic_reversible_reactions__[k]-1;
+					uKeq__[k] = std::exp(-reaction_s_over_R__[j] + reaction_h_over_RT__[j] - log_Patm_over_RT_ * changeOfMoles__[j]);
+				}
+			}
+
+			// Explicit reverse Arrhenius constants
+			for (unsigned int i = 0; i < active_explicitly_reversible_reactions__.size(); i++)
+			{
+				const unsigned int k = active_explicitly_reversible_reactions__[i];
+				kArrhenius_reversible__[k] = std::exp(lnA_reversible__[k] + Beta_reversible__[k]*this->logT_ - E_over_R_reversible__[k]*this->uT_);
+			}
+
+			// Fall-off high temperature region kinetic constants
+			for (unsigned int i = 0; i < active_falloff_reactions__.size(); i++)
+			{
+				const unsigned int k = active_falloff_reactions__[i];
+				kArrhenius_falloff_inf__[k] = std::exp(lnA_falloff_inf__[k] + Beta_falloff_inf__[k]*this->logT_ - E_over_R_falloff_inf__[k]*this->uT_);
+
+				switch(falloff_reaction_type__[k])
+				{
+					case PhysicalConstants::REACTION_TROE_FALLOFF:
+
+						logFcent_falloff__[k] = (d_falloff__[k] != 0.) ? (1.-a_falloff__[k])*std::exp(-this->T_/b_falloff__[k]) + a_falloff__[k]*std::exp(-this->T_/c_falloff__[k]) + std::exp(-d_falloff__[k]/this->T_) :
+																	 (1.-a_falloff__[k])*std::exp(-this->T_/b_falloff__[k]) + a_falloff__[k]*std::exp(-this->T_/c_falloff__[k]);
+
+						if(logFcent_falloff__[k] < 1.e-300)	logFcent_falloff__[k] = -300.;
+						else								logFcent_falloff__[k] = std::log10(logFcent_falloff__[k]);
+
+						break;
+
+					case PhysicalConstants::REACTION_SRI_FALLOFF:
+
+						logFcent_falloff__[k] = ( a_falloff__[k]*std::exp(-b_falloff__[k]/this->T_) +  std::exp(-this->T_/c_falloff__[k]));
+
+						break;
+				}
+			}
+
+			// Cabr high temperature region kinetic constants
+			for (unsigned int i = 0; i < active_cabr_reactions__.size(); i++)
+			{
+				const unsigned int k = active_cabr_reactions__[i];
+				kArrhenius_cabr_inf__[k] = std::exp(lnA_cabr_inf__[k] + Beta_cabr_inf__[k]*this->logT_ - E_over_R_cabr_inf__[k]*this->uT_);
+
+				switch(cabr_reaction_type__[k])
+				{
+					case PhysicalConstants::REACTION_TROE_CABR:
+
+						logFcent_cabr__[k] = (d_cabr__[k] != 0.) ? (1.-a_cabr__[k])*std::exp(-this->T_/b_cabr__[k]) + a_cabr__[k]*std::exp(-this->T_/c_cabr__[k]) + std::exp(-d_cabr__[k]/this->T_) :
+																 (1.-a_cabr__[k])*std::exp(-this->T_/b_cabr__[k]) + a_cabr__[k]*std::exp(-this->T_/c_cabr__[k]);
+
+						if(logFcent_cabr__[k] < 1.e-300)	logFcent_cabr__[k] = -300.;
+						else							logFcent_cabr__[k] = std::log10(logFcent_cabr__[k]);
+
+						break;
+
+					case PhysicalConstants::REACTION_SRI_CABR:
+
+						logFcent_cabr__[k] = ( a_cabr__[k]*std::exp(-b_cabr__[k]/this->T_) +  std::exp(-this->T_/c_cabr__[k]));
+
+						break;
+				}
+			}
+
+			active_kinetic_constants_must_be_recalculated_ = false;
+		}
+
+		// Chebishev-Polynomials reactions
+		for (unsigned int i = 0; i < active_chebyshev_reactions__.size(); i++)
+		{
+			const unsigned int k = active_chebyshev_reactions__[i];
+			kArrhenius__[indices_of_chebyshev_reactions__[k]-1] = chebyshev_reactions_[k].KineticConstant(this->T_, this->P_);
+		}
+
+		// Pressure logarithmic interpolated reactions
+		for (unsigned int i = 0; i < active_pressurelog_reactions__.size(); i++)
+		{
+			const unsigned int k = active_pressurelog_reactions__[i];
+			kArrhenius__[indices_of_pressurelog_reactions__[k]-1] = pressurelog_reactions_[k].KineticConstant(this->T_, this->P_);
+		}
+
+		for (unsigned int i = 0; i < active_reactions__.size(); i++)
+		{
+			const unsigned int j = active_reactions__[i];
+			kArrheniusModified__[j] = kArrhenius__[j];
+		}
+	}
+
+	double KineticsMap_CHEMKIN::ChemicallyActivatedBimolecularReactionsCorrection(const unsigned int local_k, const double cTot, const double* c)
+	{
+		double M;
+		if (cabr_index_of_single_thirdbody_species__[local_k-1] == 0)
+		{
+			M = cTot;
+			for (unsigned int s = 0; s < cabr_indices_of_thirdbody_species__[local_k-1].size(); s++)
+				M += c[cabr_indices_of_thirdbody_species__[local_k-1][s]-1] * cabr_indices_of_thirdbody_efficiencies__[local_k-1][s];
+		}
+		else
+		{
+			const double epsilon = 1.e-16;
+			M = c[cabr_index_of_single_thirdbody_species__[local_k-1]-1] + epsilon;
+		}
+
+		const unsigned int j = indices_of_cabr_reactions__[local_k-1];
+		const double Pr = kArrhenius__[j-1] * M / kArrhenius_cabr_inf__[local_k-1];
+
+		double wF = 1.;
+		switch (cabr_reaction_type__[local_k-1])
+		{
+			case PhysicalConstants::REACTION_TROE_CABR:
+			{
+				const double nTroe = 0.75 - 1.27*logFcent_cabr__[local_k-1];
+				const double cTroe = -0.4 - 0.67*logFcent_cabr__[local_k-1];
+				const double sTroe = std::log10(Pr) + cTroe;
+				wF = std::pow(10., logFcent_cabr__[local_k-1] / (1. + boost::math::pow<2>(sTroe / (nTroe - 0.14*sTroe))));
+			}
+			break;
+
+			case PhysicalConstants::REACTION_SRI_CABR:
+			{
+				const double xSRI = 1. / (1. + boost::math::pow<2>(std::log10(Pr)));
+				wF = std::pow(logFcent_cabr__[local_k-1], xSRI) * d_cabr__[local_k-1];
+				if (e_cabr__[local_k-1] != 0.)
+					wF *= std::pow(this->T_, e_cabr__[local_k-1]);
+			}
+			break;
+		}
+
+		return ( (1. / (1. + Pr)) * wF );
+	}
+
+	void KineticsMap_CHEMKIN::ReactionRatesOfActiveReactions(const double* c, const double cTot)
+	{
+		// 1. Kinetic constants
+		KineticConstantsOfActiveReactions();
+
+		// 1.bis Extended pressure log reactions
+		for (unsigned int i = 0; i < active_extendedpressurelog_reactions__.size(); i++)
+		{
+			const unsigned int k = active_extendedpressurelog_reactions__[i];
+			const unsigned int j = indices_of_extendedpressurelog_reactions__[k]-1;
+			kArrhenius__[j] = extendedpressurelog_reactions_[k].KineticConstant(this->T_, this->P_, cTot, c);
+			kArrheniusModified__[j] = kArrhenius__[j];
+		}
+
+		// 2-3. Correct the effective kinetic constants by three-body coefficients
+		for (unsigned int i = 0; i < active_thirdbody_reactions__.size(); i++)
+		{
+			const unsigned int s = active_thirdbody_reactions__[i];
+
+			Meff__[s] = cTot;
+			for (unsigned int k = 0; k < indices_of_thirdbody_species__[s].size(); k++)
+				Meff__[s] += c[indices_of_thirdbody_species__[s][k] - 1] * indices_of_thirdbody_efficiencies__[s][k];
+
+			kArrheniusModified__[indices_of_thirdbody_reactions__[s]-1] *= Meff__[s];
+		}
+
+		// 4. Correct the effective kinetic constants: Fall-off reactions
+		for (unsigned int i = 0; i < active_falloff_reactions__.size(); i++)
+		{
+			const unsigned int s = active_falloff_reactions__[i];
+			correction_falloff__[s] = FallOffReactionsCorrection(s+1, cTot, c);
+			kArrheniusModified__[indices_of_falloff_reactions__[s]-1] *= correction_falloff__[s];
+		}
+
+		// 4.bis Extended falloff reactions
+		for (unsigned int i = 0; i < active_extendedfalloff_reactions__.size(); i++)
+		{
+			const unsigned int k = active_extendedfalloff_reactions__[i];
+			const unsigned int j = indices_of_extendedfalloff_reactions__[k]-1;
+			kArrhenius__[j] = extendedfalloff_reactions_[k].KineticConstant(this->T_, this->P_, cTot, c);
+			kArrheniusModified__[j] = kArrhenius__[j];
+		}
+
+		// 5. Correct the effective kinetic constants: CABR reactions
+		for (unsigned int i = 0; i < active_cabr_reactions__.size(); i++)
+		{
+			const unsigned int s = active_cabr_reactions__[i];
+			correction_cabr__[s] = ChemicallyActivatedBimolecularReactionsCorrection(s+1, cTot, c);
+			kArrheniusModified__[indices_of_cabr_reactions__[s]-1] *= correction_cabr__[s];
+		}
+
+		// Calculates the product of concentrations (for forward and reverse reactions)
+		stoichiometry_->ProductOfConcentrationsOfActiveReactions(forwardReactionRates__, reverseReactionRates__, c);
+
+		// Corrects the product of concentrations for reverse reaction by the 
+		// thermodynamic equilibrium constant
+		for (unsigned int i = 0; i < active_thermodynamic_reversible_reactions__.size(); i++)
+		{
+			const unsigned int k = active_thermodynamic_reversible_reactions__[i];
+			reverseReactionRates__[indices_of_thermodynamic_reversible_reactions__[k]-1] *= uKeq__[k];
+		}
+
+		// Corrects the product of concentrations for reverse reaction by the 
+		// explicit Arrhenius kinetic parameters (if provided)
+		for (unsigned int i = 0; i < active_explicitly_reversible_reactions__.size(); i++)
+		{
+			const unsigned int k = active_explicitly_reversible_reactions__[i];
+			const unsigned int j = indices_of_explicitly_reversible_reactions__[k]-1;
+			reverseReactionRates__[j] *= kArrhenius_reversible__[k]/kArrhenius__[j];
+		}
+
+		// Calculates the net reaction rates (in kmol/m3/s): the rates of inactive reactions are 
+		// always set equal to zero, since they could have been calculated by ReactionRates()
+		std::fill(netReactionRates__.begin(), netReactionRates__.end(), 0.);
+		for (unsigned int i = 0; i < active_reactions__.size(); i++)
+		{
+			const unsigned int j = active_reactions__[i];
+			netReactionRates__[j] = forwardReactionRates__[j];
+		}
+		for (unsigned int i = 0; i < active_reversible_reactions__.size(); i++)
+		{
+			const unsigned int j = active_reversible_reactions__[i];
+			netReactionRates__[j] -= reverseReactionRates__[j];
+		}
+		for (unsigned int i = 0; i < active_reactions__.size(); i++)
+		{
+			const unsigned int j = active_reactions__[i];
+			netReactionRates__[j] *= kArrheniusModified__[j];
+		}
+	}
+
+	void KineticsMap_CHEMKIN::FormationRatesOfActiveReactions(double* R)
+	{
+		stoichiometry_->FormationRatesFromActiveReactionRates(R, netReactionRates__.data());
+	}
+
+	void KineticsMap_CHEMKIN::ReactionRates(const unsigned int n, const double* T, const double* P, const double* c, double* r)
+	{
+		const unsigned int NS = this->number_of_species_;
+		const unsigned int NR = this->number_of_reactions_;
+
+		// Reactions described by non conventional expressions (Chebyshev, PLOG, extended falloff)
+		// are not available in the block version: the states are evaluated one at a time
+		if ( number_of_chebyshev_reactions_ != 0 || number_of_pressurelog_reactions_ != 0 ||
+		     number_of_extendedpressurelog_reactions_ != 0 || number_of_extendedfalloff_reactions_ != 0 )
+		{
+			batch_cell_c__.resize(NS);
+			for (unsigned int p = 0; p < n; p++)
+			{
+				for (unsigned int i = 0; i < NS; i++)
+					batch_cell_c__[i] = c[i*n + p];
+
+				thermodynamics_.SetTemperature(T[p]);
+				thermodynamics_.SetPressure(P[p]);
+				SetTemperature(T[p]);
+				SetPressure(P[p]);
+				ReactionRates(batch_cell_c__.data());
+
+				for (unsigned int j = 0; j < NR; j++)
+					r[j*n + p] = netReactionRates__[j];
+			}
+
+			return;
+		}
+
+		// Memory allocation (only if the size of the block increases)
+		if (batch_logT__.size() < n)
+		{
+			batch_logT__.resize(n);
+			batch_uT__.resize(n);
+			batch_cTot__.resize(n);
+			batch_log_Patm_over_RT__.resize(n);
+			batch_M__.resize(n);
+			batch_reaction_h_over_RT__.resize(NR*n);
+			batch_reaction_s_over_R__.resize(NR*n);
+			batch_kArrhenius__.resize(NR*n);
+			batch_kArrheniusModified__.resize(NR*n);
+			batch_forwardReactionRates__.resize(NR*n);
+			batch_reverseReactionRates__.resize(NR*n);
+			batch_uKeq__.resize(number_of_thermodynamic_reversible_reactions_*n);
+			batch_kArrhenius_reversible__.resize(number_of_explicitly_reversible_reactions_*n);
+			batch_kArrhenius_falloff_inf__.resize(number_of_falloff_reactions_*n);
+			batch_logFcent_falloff__.resize(number_of_falloff_reactions_*n);
+			batch_kArrhenius_cabr_inf__.resize(number_of_cabr_reactions_*n);
+			batch_logFcent_cabr__.resize(number_of_cabr_reactions_*n);
+			batch_cell_c__.resize(NS);
+			batch_cell_a__.resize(NR);
+			batch_cell_b__.resize(NR);
+		}
+
+		double* logT = batch_logT__.data();
+		double* uT = batch_uT__.data();
+		double* cTot = batch_cTot__.data();
+		double* log_Patm_over_RT = batch_log_Patm_over_RT__.data();
+		double* M = batch_M__.data();
+		double* h = batch_reaction_h_over_RT__.data();
+		double* s = batch_reaction_s_over_R__.data();
+		double* k = batch_kArrhenius__.data();
+		double* kmod = batch_kArrheniusModified__.data();
+		double* fwd = batch_forwardReactionRates__.data();
+		double* rev = batch_reverseReactionRates__.data();
+
+		// 0. Quantities depending on the single state: reaction enthalpies and entropies and
+		//    product of concentrations (no transcendental functions, apart from fractional orders)
+		for (unsigned int p = 0; p < n; p++)
+		{
+			for (unsigned int i = 0; i < NS; i++)
+				batch_cell_c__[i] = c[i*n + p];
+
+			thermodynamics_.SetTemperature(T[p]);
+			thermodynamics_.SetPressure(P[p]);
+			stoichiometry_->ReactionEnthalpyAndEntropy(	batch_cell_a__, batch_cell_b__,
+									thermodynamics_.Species_H_over_RT(), thermodynamics_.Species_S_over_R() );
+			for (unsigned int j = 0; j < NR; j++)
+			{
+				h[j*n + p] = batch_cell_a__[j];
+				s[j*n + p] = batch_cell_b__[j];
+			}
+
+			stoichiometry_->ProductOfConcentrations(batch_cell_a__, batch_cell_b__, batch_cell_c__.data());
+			for (unsigned int j = 0; j < NR; j++)
+			{
+				fwd[j*n + p] = batch_cell_a__[j];
+				rev[j*n + p] = batch_cell_b__[j];
+			}
+		}
+
+		// 1. Temperature functions
+		for (unsigned int p = 0; p < n; p++)
+		{
+			logT[p] = std::log(T[p]);
+			uT[p] = 1. / T[p];
+			log_Patm_over_RT[p] = std::log(101325. / PhysicalConstants::R_J_kmol * uT[p]);
+		}
+
+		for (unsigned int p = 0; p < n; p++)
+			cTot[p] = 0.;
+		for (unsigned int i = 0; i < NS; i++)
+		{
+			const double* ci = &c[i*n];
+			for (unsigned int p = 0; p < n; p++)
+				cTot[p] += ci[p];
+		}
+
+		// 2. Forward kinetic constants (Arrhenius' Law)
+		for (unsigned int j = 0; j < NR; j++)
+		{
+			const double lnA = lnA__[j];
+			const double Beta = Beta__[j];
+			const double E_over_R = E_over_R__[j];
+			double* kj = &k[j*n];
+			for (unsigned int p = 0; p < n; p++)
+				kj[p] = std::exp(lnA + Beta*logT[p] - E_over_R*uT[p]);
+		}
+
+		// Negative frequency factors: reactions must be reversed
+		for (unsigned int q = 0; q < negative_lnA__.size(); q++)
+		{
+			double* kj = &k[(negative_lnA__[q]-1)*n];
+			for (unsigned int p = 0; p < n; p++)
+				kj[p] *= -1.;
+		}
+
+		// 3. Equilibrium constants (inverse value)
+		for (unsigned int q = 0; q < number_of_thermodynamic_reversible_reactions_; q++)
+		{
+			const unsigned int j = indices_of_thermodynamic_reversible_reactions__[q]-1;
+			const double dn = changeOfMoles__[j];
+			const double* hj = &h[j*n];
+			const double* sj = &s[j*n];
+			double* uKeq = &batch_uKeq__[q*n];
+			for (unsigned int p = 0; p < n; p++)
+				uKeq[p] = std::exp(-sj[p] + hj[p] - log_Patm_over_RT[p] * dn);
+		}
+
+		// 4. Explicit reverse Arrhenius constants
+		for (unsigned int q = 0; q < number_of_explicitly_reversible_reactions_; q++)
+		{
+			const double lnA = lnA_reversible__[q];
+			const double Beta = Beta_reversible__[q];
+			const double E_over_R = E_over_R_reversible__[q];
+			double* kq = &batch_kArrhenius_reversible__[q*n];
+			for (unsigned int p = 0; p < n; p++)
+				kq[p] = std::exp(lnA + Beta*logT[p] - E_over_R*uT[p]);
+		}
+
+		// 5. Effective kinetic constants
+		for (unsigned int i = 0; i < NR*n; i++)
+			kmod[i] = k[i];
+
+		// 5a. Three-body corrections
+		for (unsigned int q = 0; q < number_of_thirdbody_reactions_; q++)
+		{
+			const unsigned int j = indices_of_thirdbody_reactions__[q]-1;
+
+			for (unsigned int p = 0; p < n; p++)
+				M[p] = cTot[p];
+			for (unsigned int i = 0; i < indices_of_thirdbody_species__[q].size(); i++)
+			{
+				const double efficiency = indices_of_thirdbody_efficiencies__[q][i];
+				const double* ci = &c[(indices_of_thirdbody_species__[q][i]-1)*n];
+				for (unsigned int p = 0; p < n; p++)
+					M[p] += ci[p] * efficiency;
+			}
+
+			double* kmodj = &kmod[j*n];
+			for (unsigned int p = 0; p < n; p++)
+				kmodj[p] *= M[p];
+		}
+
+		// 5b. Fall-off reactions (Lindemann, Troe, SRI)
+		for (unsigned int q = 0; q < number_of_falloff_reactions_; q++)
+		{
+			const unsigned int j = indices_of_falloff_reactions__[q]-1;
+			const double lnA = lnA_falloff_inf__[q];
+			const double Beta = Beta_falloff_inf__[q];
+			const double E_over_R = E_over_R_falloff_inf__[q];
+			const double a = a_falloff__[q];
+			const double b = b_falloff__[q];
+			const double cc = c_falloff__[q];
+			const double d = d_falloff__[q];
+			const double e = e_falloff__[q];
+
+			double* kinf = &batch_kArrhenius_falloff_inf__[q*n];
+			double* logFcent = &batch_logFcent_falloff__[q*n];
+			const double* kj = &k[j*n];
+			double* kmodj = &kmod[j*n];
+
+			for (unsigned int p = 0; p < n; p++)
+				kinf[p] = std::exp(lnA + Beta*logT[p] - E_over_R*uT[p]);
+
+			// Third-body concentration
+			if (falloff_index_of_single_thirdbody_species__[q] == 0)
+			{
+				for (unsigned int p = 0; p < n; p++)
+					M[p] = cTot[p];
+				for (unsigned int i = 0; i < falloff_indices_of_thirdbody_species__[q].size(); i++)
+				{
+					const double efficiency = falloff_indices_of_thirdbody_efficiencies__[q][i];
+					const double* ci = &c[(falloff_indices_of_thirdbody_species__[q][i]-1)*n];
+					for (unsigned int p = 0; p < n; p++)
+						M[p] += ci[p] * efficiency;
+				}
+			}
+			else
+			{
+				const double epsilon = 1.e-16;
+				const double* ci = &c[(falloff_index_of_single_thirdbody_species__[q]-1)*n];
+				for (unsigned int p = 0; p < n; p++)
+					M[p] = ci[p] + epsilon;
+			}
+
+			switch(falloff_reaction_type__[q])
+			{
+				case PhysicalConstants::REACTION_TROE_FALLOFF:
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						double Fcent = (1.-a)*std::exp(-T[p]/b) + a*std::exp(-T[p]/cc);
+						if (d != 0.) Fcent += std::exp(-d*uT[p]);
+						logFcent[p] = (Fcent < 1.e-300) ? -300. : std::log10(Fcent);
+					}
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						const double Pr = kj[p] * M[p] / kinf[p];
+						double wF;
+						if (Pr > 1.e-32)
+						{
+							const double nTroe = 0.75-1.27*logFcent[p];
+							const double cTroe = -0.4-0.67*logFcent[p];
+							const double sTroe = std::log10(Pr) + cTroe;
+							wF = std::pow(10., logFcent[p]/(1. + boost::math::pow<2>(sTroe/(nTroe-0.14*sTroe))));
+						}
+						else
+						{
+							// Asymptotic value for wF when sTroe --> -Inf
+							wF = std::pow(10., logFcent[p]/(1. + boost::math::pow<2>(1./0.14)));
+						}
+						kmodj[p] = kinf[p] * (Pr/(1.+Pr)) * wF;
+					}
+
+					break;
+
+				case PhysicalConstants::REACTION_SRI_FALLOFF:
+
+					for (unsigned int p = 0; p < n; p++)
+						logFcent[p] = a*std::exp(-b*uT[p]) + std::exp(-T[p]/cc);
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						const double Pr = kj[p] * M[p] / kinf[p];
+						const double xSRI = 1. / (1. + boost::math::pow<2>(std::log10(Pr)));
+						double wF = std::pow(logFcent[p], xSRI) * d;
+						if (e != 0.)
+							wF *= std::pow(T[p], e);
+						kmodj[p] = kinf[p] * (Pr/(1.+Pr)) * wF;
+					}
+
+					break;
+
+				default:
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						const double Pr = kj[p] * M[p] / kinf[p];
+						kmodj[p] = kinf[p] * (Pr/(1.+Pr));
+					}
+
+					break;
+			}
+		}
+
+		// 5c. Chemically activated bimolecular reactions (Lindemann, Troe, SRI)
+		for (unsigned int q = 0; q < number_of_cabr_reactions_; q++)
+		{
+			const unsigned int j = indices_of_cabr_reactions__[q]-1;
+			const double lnA = lnA_cabr_inf__[q];
+			const double Beta = Beta_cabr_inf__[q];
+			const double E_over_R = E_over_R_cabr_inf__[q];
+			const double a = a_cabr__[q];
+			const double b = b_cabr__[q];
+			const double cc = c_cabr__[q];
+			const double d = d_cabr__[q];
+			const double e = e_cabr__[q];
+
+			double* kinf = &batch_kArrhenius_cabr_inf__[q*n];
+			double* logFcent = &batch_logFcent_cabr__[q*n];
+			const double* kj = &k[j*n];
+			double* kmodj = &kmod[j*n];
+
+			for (unsigned int p = 0; p < n; p++)
+				kinf[p] = std::exp(lnA + Beta*logT[p] - E_over_R*uT[p]);
+
+			// Third-body concentration
+			if (cabr_index_of_single_thirdbody_species__[q] == 0)
+			{
+				for (unsigned int p = 0; p < n; p++)
+					M[p] = cTot[p];
+				for (unsigned int i = 0; i < cabr_indices_of_thirdbody_species__[q].size(); i++)
+				{
+					const double efficiency = cabr_indices_of_thirdbody_efficiencies__[q][i];
+					const double* ci = &c[(cabr_indices_of_thirdbody_species__[q][i]-1)*n];
+					for (unsigned int p = 0; p < n; p++)
+						M[p] += ci[p] * efficiency;
+				}
+			}
+			else
+			{
+				const double epsilon = 1.e-16;
+				const double* ci = &c[(cabr_index_of_single_thirdbody_species__[q]-1)*n];
+				for (unsigned int p = 0; p < n; p++)
+					M[p] = ci[p] + epsilon;
+			}
+
+			switch(cabr_reaction_type__[q])
+			{
+				case PhysicalConstants::REACTION_TROE_CABR:
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						double Fcent = (1.-a)*std::exp(-T[p]/b) + a*std::exp(-T[p]/cc);
+						if (d != 0.) Fcent += std::exp(-d*uT[p]);
+						logFcent[p] = (Fcent < 1.e-300) ? -300. : std::log10(Fcent);
+					}
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						const double Pr = kj[p] * M[p] / kinf[p];
+						const double nTroe = 0.75-1.27*logFcent[p];
+						const double cTroe = -0.4-0.67*logFcent[p];
+						const double sTroe = std::log10(Pr) + cTroe;
+						const double wF = std::pow(10., logFcent[p]/(1. + boost::math::pow<2>(sTroe/(nTroe-0.14*sTroe))));
+						kmodj[p] *= (1./(1.+Pr)) * wF;
+					}
+
+					break;
+
+				case PhysicalConstants::REACTION_SRI_CABR:
+
+					for (unsigned int p = 0; p < n; p++)
+						logFcent[p] = a*std::exp(-b*uT[p]) + std::exp(-T[p]/cc);
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						const double Pr = kj[p] * M[p] / kinf[p];
+						const double xSRI = 1. / (1. + boost::math::pow<2>(std::log10(Pr)));
+						double wF = std::pow(logFcent[p], xSRI) * d;
+						if (e != 0.)
+							wF *= std::pow(T[p], e);
+						kmodj[p] *= (1./(1.+Pr)) * wF;
+					}
+
+					break;
+
+				default:
+
+					for (unsigned int p = 0; p < n; p++)
+					{
+						const double Pr = kj[p] * M[p] / kinf[p];
+						kmodj[p] *= 1./(1.+Pr);
+					}
+
+					break;
+			}
+		}
+
+		// 6. Corrects the product of concentrations for reverse reactions by the
+		//    thermodynamic equilibrium constant or by the explicit reverse kinetic constant
+		for (unsigned int q = 0; q < number_of_thermodynamic_reversible_reactions_; q++)
+		{
+			const unsigned int j = indices_of_thermodynamic_reversible_reactions__[q]-1;
+			const double* uKeq = &batch_uKeq__[q*n];
+			double* revj = &rev[j*n];
+			for (unsigned int p = 0; p < n; p++)
+				revj[p] *= uKeq[p];
+		}
+
+		for (unsigned int q = 0; q < number_of_explicitly_reversible_reactions_; q++)
+		{
+			const unsigned int j = indices_of_explicitly_reversible_reactions__[q]-1;
+			const double* kq = &batch_kArrhenius_reversible__[q*n];
+			const double* kj = &k[j*n];
+			double* revj = &rev[j*n];
+			for (unsigned int p = 0; p < n; p++)
+				revj[p] *= kq[p]/kj[p];
+		}
+
+		// 7. Net reaction rates [kmol/m3/s]
+		for (unsigned int q = 0; q < number_of_reversible_reactions_; q++)
+		{
+			const unsigned int j = indices_of_reversible_reactions__[q]-1;
+			double* fwdj = &fwd[j*n];
+			const double* revj = &rev[j*n];
+			for (unsigned int p = 0; p < n; p++)
+				fwdj[p] -= revj[p];
+		}
+
+		for (unsigned int i = 0; i < NR*n; i++)
+			r[i] = fwd[i] * kmod[i];
+	}
+
 	void KineticsMap_CHEMKIN::DerivativesOfReactionRatesWithRespectToKineticParameters(const PhysicalConstants::sensitivity_type type, unsigned int jReaction, const double* c, double& parameter)
 	{
 		// Total concentration
@@ -1958,6 +2883,26 @@ namespace OpenSMOKE
 		stoichiometry_->FormationRatesFromReactionRates(R, netReactionRates__.data());
 	}
 
+	void KineticsMap_CHEMKIN::FormationRates(const unsigned int n, const double* r, double* R)
+	{
+		const unsigned int NS = this->number_of_species_;
+		const unsigned int NR = this->number_of_reactions_;
+
+		batch_cell_a__.resize(NR);
+		batch_cell_R__.resize(NS);
+
+		for (unsigned int p = 0; p < n; p++)
+		{
+			for (unsigned int j = 0; j < NR; j++)
+				batch_cell_a__[j] = r[j*n + p];
+
+			stoichiometry_->FormationRatesFromReactionRates(batch_cell_R__.data(), batch_cell_a__.data());
+
+			for (unsigned int i = 0; i < NS; i++)
+				R[i*n + p] = batch_cell_R__[i];
+		}
+	}
+
 	double KineticsMap_CHEMKIN::HeatRelease(const double* R)
 	{
 		return -Dot(this->number_of_species_, R, thermodynamics_.Species_H_over_RT().data()) * PhysicalConstants::R_J_kmol * this->T_;
@@ -3054,6 +3999,197 @@ namespace OpenSMOKE
 		}
 	}
 
+	void KineticsMap_CHEMKIN::SparseDerivativesPattern()
+	{
+		const unsigned int NS = this->number_of_species_;
+		const unsigned int NR = this->number_of_reactions_;
+
+		// Species affecting the rate of each reaction (at fixed total concentration)
+		std::vector< std::vector<unsigned int> > influencing(NR);
+		for (int k = 0; k < stoichiometry_->reactionorders_matrix_reactants().outerSize(); ++k)
+			for (Eigen::SparseMatrix<double>::InnerIterator it(stoichiometry_->reactionorders_matrix_reactants(), k); it; ++it)
+				influencing[it.row()].push_back(it.col());
+		for (int k = 0; k < stoichiometry_->reactionorders_matrix_products().outerSize(); ++k)
+			for (Eigen::SparseMatrix<double>::InnerIterator it(stoichiometry_->reactionorders_matrix_products(), k); it; ++it)
+				influencing[it.row()].push_back(it.col());
+
+		// Third-body efficiencies
+		for (unsigned int s = 0; s < number_of_thirdbody_reactions_; s++)
+			for (unsigned int k = 0; k < indices_of_thirdbody_species__[s].size(); k++)
+				influencing[indices_of_thirdbody_reactions__[s] - 1].push_back(indices_of_thirdbody_species__[s][k] - 1);
+
+		// Fall-off efficiencies
+		for (unsigned int s = 0; s < number_of_falloff_reactions_; s++)
+		{
+			const unsigned int j = indices_of_falloff_reactions__[s] - 1;
+			if (falloff_index_of_single_thirdbody_species__[s] != 0)
+				influencing[j].push_back(falloff_index_of_single_thirdbody_species__[s] - 1);
+			for (unsigned int k = 0; k < falloff_indices_of_thirdbody_species__[s].size(); k++)
+				influencing[j].push_back(falloff_indices_of_thirdbody_species__[s][k] - 1);
+		}
+
+		// CABR efficiencies
+		for (unsigned int s = 0; s < number_of_cabr_reactions_; s++)
+		{
+			const unsigned int j = indices_of_cabr_reactions__[s] - 1;
+			if (cabr_index_of_single_thirdbody_species__[s] != 0)
+				influencing[j].push_back(cabr_index_of_single_thirdbody_species__[s] - 1);
+			for (unsigned int k = 0; k < cabr_indices_of_thirdbody_species__[s].size(); k++)
+				influencing[j].push_back(cabr_indices_of_thirdbody_species__[s][k] - 1);
+		}
+
+		// Extended fall-off and PLOG reactions can depend on every species
+		for (unsigned int s = 0; s < number_of_extendedfalloff_reactions_; s++)
+			for (unsigned int i = 0; i < NS; i++)
+				influencing[indices_of_extendedfalloff_reactions__[s] - 1].push_back(i);
+		for (unsigned int s = 0; s < number_of_extendedpressurelog_reactions_; s++)
+			for (unsigned int i = 0; i < NS; i++)
+				influencing[indices_of_extendedpressurelog_reactions__[s] - 1].push_back(i);
+
+		// Species whose formation rate is affected by each reaction
+		std::vector< std::vector<unsigned int> > affected(NR);
+		for (int k = 0; k < stoichiometry_->stoichiometric_matrix_reactants().outerSize(); ++k)
+			for (Eigen::SparseMatrix<double>::InnerIterator it(stoichiometry_->stoichiometric_matrix_reactants(), k); it; ++it)
+				affected[it.row()].push_back(it.col());
+		for (int k = 0; k < stoichiometry_->stoichiometric_matrix_products().outerSize(); ++k)
+			for (Eigen::SparseMatrix<double>::InnerIterator it(stoichiometry_->stoichiometric_matrix_products(), k); it; ++it)
+				affected[it.row()].push_back(it.col());
+
+		// Sparsity pattern (column j: formation rates depending on species j)
+		std::vector<bool> mask(NS*NS, false);
+		for (unsigned int i = 0; i < NS; i++)
+			mask[i*NS + i] = true;
+		for (unsigned int j = 0; j < NR; j++)
+			for (unsigned int a = 0; a < influencing[j].size(); a++)
+				for (unsigned int b = 0; b < affected[j].size(); b++)
+					mask[influencing[j][a] * NS + affected[j][b]] = true;
+
+		typedef Eigen::Triplet<double> list_of_values;
+		std::vector<list_of_values> tripletList;
+		std::vector< std::pair<int, unsigned int> > column_sizes(NS);
+		for (unsigned int j = 0; j < NS; j++)
+		{
+			unsigned int count = 0;
+			for (unsigned int i = 0; i < NS; i++)
+				if (mask[j*NS + i] == true)
+				{
+					tripletList.push_back(list_of_values(i, j, 0.));
+					count++;
+				}
+			column_sizes[j] = std::make_pair(-static_cast<int>(count), j);
+		}
+
+		sparse_derivatives_pattern_.resize(NS, NS);
+		sparse_derivatives_pattern_.setFromTriplets(tripletList.begin(), tripletList.end());
+		sparse_derivatives_pattern_.makeCompressed();
+
+		// Greedy grouping of structurally orthogonal columns (largest columns first)
+		std::sort(column_sizes.begin(), column_sizes.end());
+		sparse_derivatives_groups__.resize(0);
+		std::vector< std::vector<bool> > rows_in_group;
+		for (unsigned int k = 0; k < NS; k++)
+		{
+			const unsigned int j = column_sizes[k].second;
+
+			unsigned int g = 0;
+			for (g = 0; g < sparse_derivatives_groups__.size(); g++)
+			{
+				bool orthogonal = true;
+				for (Eigen::SparseMatrix<double>::InnerIterator it(sparse_derivatives_pattern_, j); it; ++it)
+					if (rows_in_group[g][it.row()] == true)
+					{
+						orthogonal = false;
+						break;
+					}
+				if (orthogonal == true)
+					break;
+			}
+
+			if (g == sparse_derivatives_groups__.size())
+			{
+				sparse_derivatives_groups__.push_back(std::vector<unsigned int>());
+				rows_in_group.push_back(std::vector<bool>(NS, false));
+			}
+
+			sparse_derivatives_groups__[g].push_back(j);
+			for (Eigen::SparseMatrix<double>::InnerIterator it(sparse_derivatives_pattern_, j); it; ++it)
+				rows_in_group[g][it.row()] = true;
+		}
+
+		sparse_derivatives_c__.resize(NS);
+		sparse_derivatives_dc__.resize(NS);
+		sparse_derivatives_R__.resize(NS);
+		sparse_derivatives_Rplus__.resize(NS);
+
+		sparse_derivatives_available_ = true;
+	}
+
+	unsigned int KineticsMap_CHEMKIN::NumberOfSparseDerivativesGroups()
+	{
+		if (sparse_derivatives_available_ == false)
+			SparseDerivativesPattern();
+
+		return static_cast<unsigned int>(sparse_derivatives_groups__.size());
+	}
+
+	void KineticsMap_CHEMKIN::DerivativesOfFormationRates(const double cTot, const double* c, Eigen::SparseMatrix<double>* dR_over_dC)
+	{
+		const double ZERO_DER = std::sqrt(OPENSMOKE_TINY_FLOAT);
+		const double ETA2 = std::sqrt(OPENSMOKE_MACH_EPS_DOUBLE);
+		const double TOLR = 100. * OPENSMOKE_MACH_EPS_FLOAT;
+		const double TOLA = 1.e-10;
+
+		if (sparse_derivatives_available_ == false)
+			SparseDerivativesPattern();
+
+		if (dR_over_dC->rows() != sparse_derivatives_pattern_.rows() || dR_over_dC->nonZeros() != sparse_derivatives_pattern_.nonZeros())
+			*dR_over_dC = sparse_derivatives_pattern_;
+
+		for (unsigned int i = 0; i < this->number_of_species_; i++)
+			sparse_derivatives_c__[i] = c[i];
+
+		// Calculates centered values
+		ReactionRates(c, cTot);
+		FormationRates(sparse_derivatives_R__.data());
+
+		for (unsigned int g = 0; g < sparse_derivatives_groups__.size(); g++)
+		{
+			// Perturbs all the species of the group
+			for (unsigned int k = 0; k < sparse_derivatives_groups__[g].size(); k++)
+			{
+				const unsigned int j = sparse_derivatives_groups__[g][k];
+
+				// The same increment is used for vanishing concentrations (it becomes TOLA), since the
+				// 1.e-3 kmol/m3 increment of the dense version is comparable to the total concentration
+				const double hf = 1.e0;
+				const double error_weight = 1. / (TOLA + TOLR*std::fabs(c[j]));
+				double hJ = ETA2 * std::fabs(std::max(c[j], 1. / error_weight));
+				const double hJf = hf / error_weight;
+				hJ = std::max(hJ, hJf);
+				hJ = std::max(hJ, ZERO_DER);
+				const double dc = std::min(hJ, 1.e-3 + 1e-3*std::fabs(c[j]));
+
+				sparse_derivatives_dc__[j] = dc;
+				sparse_derivatives_c__[j] += dc;
+			}
+
+			ReactionRates(sparse_derivatives_c__.data(), cTot);
+			FormationRates(sparse_derivatives_Rplus__.data());
+
+			// Each row of the group's columns is affected by one perturbation only
+			for (unsigned int k = 0; k < sparse_derivatives_groups__[g].size(); k++)
+			{
+				const unsigned int j = sparse_derivatives_groups__[g][k];
+				const double udc = 1. / sparse_derivatives_dc__[j];
+
+				for (Eigen::SparseMatrix<double>::InnerIterator it(*dR_over_dC, j); it; ++it)
+					it.valueRef() = (sparse_derivatives_Rplus__[it.row()] - sparse_derivatives_R__[it.row()]) * udc;
+
+				sparse_derivatives_c__[j] = c[j];
+			}
+		}
+	}
+
 	void KineticsMap_CHEMKIN::Derivatives(const double* c, Eigen::MatrixXd* derivatives, const bool constant_density)
 	{
 		const double ZERO_DER = std::sqrt(OPENSMOKE_TINY_FLOAT);
@@ -126,6 +126,33 @@ namespace OpenSMOKE
 		*/
 		void FormationRatesFromReactionRates(double* R, const double* r);
 
+		/**
+		*@brief Builds the compacted (reaction by reaction) stoichiometry of a subset of reactions (active reactions).
+		        The functions working on the active reactions have a cost proportional to the size of the subset.
+		*@param indices indices of active reactions (zero-based)
+		*/
+		void SetActiveReactions(const std::vector<unsigned int>& indices);
+
+		/**
+		*@brief Returns the indices of active reactions (zero-based)
+		*/
+		const std::vector<unsigned int>& active_reactions() const { return active_reactions_; }
+
+		/**
+		*@brief Evaluates the reaction enthalpies and entropies of the active reactions only
+		*/
+		void ReactionEnthalpyAndEntropyOfActiveReactions(std::vector<double>& reaction_dh_over_RT, std::vector<double>& reaction_ds_over_R, const std::vector<double>& species_h_over_RT, const std::vector<double>& species_s_over_R);
+
+		/**
+		*@brief Evaluates the product of concentrations of the active reactions only (the other elements are not modified)
+		*/
+		void ProductOfConcentrationsOfActiveReactions(std::vector<double>& productDirect, std::vector<double>& productReverse, const double* c);
+
+		/**
+		*@brief Evaluates the formation rates from the reaction rates of the active reactions only
+		*/
+		void FormationRatesFromActiveReactionRates(double* R, const double* r);
+
 		/**
 		*@brief Evaluates the Production and the destruction rates from the reaction rates
 		*/
@@ -250,6 +277,25 @@ namespace OpenSMOKE
 		std::vector< std::vector<unsigned int> >	non_elementary_reactions_species_indices_reverse_;
 		std::vector< std::vector<double> >			non_elementary_reactions_orders_reverse_;
 
+		double NonElementaryProductOfConcentrations(const std::vector<unsigned int>& species, const std::vector<double>& orders, const double* c) const;
+		static double PowerOfConcentration(const double c, const double order);
+
+		bool areTheActiveReactionsMatricesAvailable_;
+		Eigen::SparseMatrix<double, Eigen::RowMajor> net_stoichiometric_matrix_rows_;		//!< net stoichiometric coefficients (reactions x species)
+		Eigen::SparseMatrix<double, Eigen::RowMajor> reactionorders_matrix_reactants_rows_;	//!< reaction orders, forward (reactions x species)
+		Eigen::SparseMatrix<double, Eigen::RowMajor> reactionorders_matrix_products_rows_;	//!< reaction orders, reverse (reactions x species)
+
+		std::vector<unsigned int>	active_reactions_;		//!< indices of active reactions (zero-based)
+		std::vector<unsigned int>	active_nu_begin_;		//!< first net stoichiometric coefficient of each active reaction
+		std::vector<unsigned int>	active_nu_species_;		//!< species of the net stoichiometric coefficients (zero-based)
+		std::vector<double>		active_nu_;			//!< net stoichiometric coefficients
+		std::vector<unsigned int>	active_lambda_direct_begin_;	//!< first forward reaction order of each active reaction
+		std::vector<unsigned int>	active_lambda_direct_species_;	//!< species of the forward reaction orders (zero-based)
+		std::vector<double>		active_lambda_direct_;		//!< forward reaction orders
+		std::vector<unsigned int>	active_lambda_reverse_begin_;	//!< first reverse reaction order of each active reaction
+		std::vector<unsigned int>	active_lambda_reverse_species_;	//!< species of the reverse reaction orders (zero-based)
+		std::vector<double>		active_lambda_reverse_;		//!< reverse reaction orders
+
 	};
 }
 
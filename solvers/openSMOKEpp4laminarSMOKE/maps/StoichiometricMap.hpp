@@ -57,6 +57,7 @@ namespace OpenSMOKE
 		isTheStoichiometricMatrixAvailable_ = false;
 		isTheReactionOrderMatrixAvailable_ = false;
 		areTheContributionOfRateOfFormationMatricesAvailable_ = false;
+		areTheActiveReactionsMatricesAvailable_ = false;
 		non_elementary_reactions_direct_ = 0;
 		non_elementary_reactions_reverse_ = 0;
 	}
@@ -71,6 +72,7 @@ namespace OpenSMOKE
 		isTheStoichiometricMatrixAvailable_ = false;
 		isTheReactionOrderMatrixAvailable_ = false;
 		areTheContributionOfRateOfFormationMatricesAvailable_ = false;
+		areTheActiveReactionsMatricesAvailable_ = false;
 		non_elementary_reactions_direct_ = 0;
 		non_elementary_reactions_reverse_ = 0;
 	}
@@ -598,6 +600,18 @@ namespace OpenSMOKE
 	}
 
 	void StoichiometricMap::ProductOfConcentrationsForNonElementaryReactions(std::vector<double>& productDirect, std::vector<double>& productReverse, const double* c)
+	{
+		for (unsigned int j = 0; j < number_of_reactions_; j++)
+		{
+			if (is_non_elementary_reaction_direct_[j] == true)
+				productDirect[j] = NonElementaryProductOfConcentrations(non_elementary_reactions_species_indices_direct_[j], non_elementary_reactions_orders_direct_[j], c);
+
+			if (is_non_elementary_reaction_reverse_[j] == true)
+				productReverse[j] = NonElementaryProductOfConcentrations(non_elementary_reactions_species_indices_reverse_[j], non_elementary_reactions_orders_reverse_[j], c);
+		}
+	}
+
+	double StoichiometricMap::NonElementaryProductOfConcentrations(const std::vector<unsigned int>& species, const std::vector<double>& orders, const double* c) const
 	{
 		const double Cstar = 1.e-8;
 		const double ALFA = 1.e-5;
@@ -605,51 +619,153 @@ namespace OpenSMOKE
 		const double K = 2.00*std::log((1. - ALFA) / ALFA) / Cstar;
 		const double delta = 1.e9;
 
-		for (unsigned int j = 0; j < number_of_reactions_; j++)
+		double product = 1.;
+		for (unsigned int i = 0; i < species.size(); i++)
 		{
-			if (is_non_elementary_reaction_direct_[j] == true)
+			const double C = c[species[i]];
+			const double lambda = orders[i];
+
+			if (lambda >= 1.)
 			{
-				productDirect[j] = 1.;
+				product *= std::pow(C, lambda);
+			}
+			else
+			{
+				const double m = (std::tanh(K*C + H) + 1.) / 2.;	// transition is for 9.e-6 < C < 1.5e-5 [kmol/m3]
+				const double gamma = m*pow(C + m / delta, lambda) + (1. - m)*pow(Cstar, lambda - 1.)*C;
+				product *= gamma;
+			}
+		}
 
-				for (unsigned int i = 0; i < non_elementary_reactions_species_indices_direct_[j].size(); i++)
-				{
-					const double C = c[non_elementary_reactions_species_indices_direct_[j][i]];
-					const double lambda = non_elementary_reactions_orders_direct_[j][i];
+		return product;
+	}
 
-					if (lambda >= 1.)
-					{
-						productDirect[j] *= std::pow(C, lambda);
-					}
-					else
-					{
-						const double m = (std::tanh(K*C + H) + 1.) / 2.;	// transition is for 9.e-6 < C < 1.5e-5 [kmol/m3]
-						const double gamma = m*pow(C + m / delta, lambda) + (1. - m)*pow(Cstar, lambda - 1.)*C;
-						productDirect[j] *= gamma;
-					}
-				}
+	double StoichiometricMap::PowerOfConcentration(const double c, const double order)
+	{
+		if (order == 1.)	return c;
+		if (order == 2.)	return c*c;
+		if (order == 3.)	return c*c*c;
+		if (order == 0.5)	return std::sqrt(c);
+		return std::pow(c, order);
+	}
+
+	void StoichiometricMap::SetActiveReactions(const std::vector<unsigned int>& indices)
+	{
+		if (areTheActiveReactionsMatricesAvailable_ == false)
+		{
+			BuildStoichiometricMatrix();
+			BuildReactionOrdersMatrix();
+
+			net_stoichiometric_matrix_rows_ = stoichiometric_matrix_products_ - stoichiometric_matrix_reactants_;
+			net_stoichiometric_matrix_rows_.prune(0.);
+			reactionorders_matrix_reactants_rows_ = reactionorders_matrix_reactants_;
+			reactionorders_matrix_products_rows_ = reactionorders_matrix_products_;
+
+			areTheActiveReactionsMatricesAvailable_ = true;
+		}
+
+		active_reactions_ = indices;
+
+		active_nu_begin_.resize(indices.size()+1);
+		active_lambda_direct_begin_.resize(indices.size()+1);
+		active_lambda_reverse_begin_.resize(indices.size()+1);
+		active_nu_species_.clear();
+		active_nu_.clear();
+		active_lambda_direct_species_.clear();
+		active_lambda_direct_.clear();
+		active_lambda_reverse_species_.clear();
+		active_lambda_reverse_.clear();
+
+		for (unsigned int a = 0; a < indices.size(); a++)
+		{
+			const unsigned int j = indices[a];
+
+			active_nu_begin_[a] = active_nu_.size();
+			for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(net_stoichiometric_matrix_rows_, j); it; ++it)
+			{
+				active_nu_species_.push_back(it.col());
+				active_nu_.push_back(it.value());
 			}
 
-			if (is_non_elementary_reaction_reverse_[j] == true)
+			active_lambda_direct_begin_[a] = active_lambda_direct_.size();
+			for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(reactionorders_matrix_reactants_rows_, j); it; ++it)
 			{
-				productReverse[j] = 1.;
+				active_lambda_direct_species_.push_back(it.col());
+				active_lambda_direct_.push_back(it.value());
+			}
 
-				for (unsigned int i = 0; i < non_elementary_reactions_species_indices_reverse_[j].size(); i++)
-				{
-					const double C = c[non_elementary_reactions_species_indices_reverse_[j][i]];
-					const double lambda = non_elementary_reactions_orders_reverse_[j][i];
+			active_lambda_reverse_begin_[a] = active_lambda_reverse_.size();
+			for (Eigen::SparseMatrix<double, Eigen::RowMajor>::InnerIterator it(reactionorders_matrix_products_rows_, j); it; ++it)
+			{
+				active_lambda_reverse_species_.push_back(it.col());
+				active_lambda_reverse_.push_back(it.value());
+			}
+		}
 
-					if (lambda >= 1.)
-					{
-						productReverse[j] *= std::pow(C, lambda);
-					}
-					else
-					{
-						const double m = (std::tanh(K*C + H) + 1.) / 2.;	// transition is for 9.e-6 < C < 1.5e-5 [kmol/m3]
-						const double gamma = m*pow(C + m / delta, lambda) + (1. - m)*pow(Cstar, lambda - 1.)*C;
-						productReverse[j] *= gamma;
-					}
-				}
+		active_nu_begin_[indices.size()] = active_nu_.size();
+		active_lambda_direct_begin_[indices.size()] = active_lambda_direct_.size();
+		active_lambda_reverse_begin_[indices.size()] = active_lambda_reverse_.size();
+	}
+
+	void StoichiometricMap::ReactionEnthalpyAndEntropyOfActiveReactions(std::vector<double>& reaction_dh_over_RT, std::vector<double>& reaction_ds_over_R, const std::vector<double>& species_h_over_RT, const std::vector<double>& species_s_over_R)
+	{
+		for (unsigned int a = 0; a < active_reactions_.size(); a++)
+		{
+			double dh = 0.;
+			double ds = 0.;
+			for (unsigned int k = active_nu_begin_[a]; k < active_nu_begin_[a+1]; k++)
+			{
+				dh += active_nu_[k] * species_h_over_RT[active_nu_species_[k]];
+				ds += active_nu_[k] * species_s_over_R[active_nu_species_[k]];
+			}
+
+			reaction_dh_over_RT[active_reactions_[a]] = dh;
+			reaction_ds_over_R[active_reactions_[a]] = ds;
+		}
+	}
+
+	void StoichiometricMap::ProductOfConcentrationsOfActiveReactions(std::vector<double>& productDirect, std::vector<double>& productReverse, const double* c)
+	{
+		for (unsigned int a = 0; a < active_reactions_.size(); a++)
+		{
+			const unsigned int j = active_reactions_[a];
+
+			if (non_elementary_reactions_direct_ != 0 && is_non_elementary_reaction_direct_[j] == true)
+			{
+				productDirect[j] = NonElementaryProductOfConcentrations(non_elementary_reactions_species_indices_direct_[j], non_elementary_reactions_orders_direct_[j], c);
+			}
+			else
+			{
+				double product = 1.;
+				for (unsigned int k = active_lambda_direct_begin_[a]; k < active_lambda_direct_begin_[a+1]; k++)
+					product *= PowerOfConcentration(c[active_lambda_direct_species_[k]], active_lambda_direct_[k]);
+				productDirect[j] = product;
+			}
+
+			if (non_elementary_reactions_reverse_ != 0 && is_non_elementary_reaction_reverse_[j] == true)
+			{
+				productReverse[j] = NonElementaryProductOfConcentrations(non_elementary_reactions_species_indices_reverse_[j], non_elementary_reactions_orders_reverse_[j], c);
 			}
+			else
+			{
+				double product = 1.;
+				for (unsigned int k = active_lambda_reverse_begin_[a]; k < active_lambda_reverse_begin_[a+1]; k++)
+					product *= PowerOfConcentration(c[active_lambda_reverse_species_[k]], active_lambda_reverse_[k]);
+				productReverse[j] = product;
+			}
+		}
+	}
+
+	void StoichiometricMap::FormationRatesFromActiveReactionRates(double* R, const double* r)
+	{
+		for (unsigned int i = 0; i < number_of_species_; i++)
+			R[i] = 0.;
+
+		for (unsigned int a = 0; a < active_reactions_.size(); a++)
+		{
+			const double rate = r[active_reactions_[a]];
+			for (unsigned int k = active_nu_begin_[a]; k < active_nu_begin_[a+1]; k++)
+				R[active_nu_species_[k]] += active_nu_[k] * rate;
 		}
 	}
 
@@ -66,6 +66,14 @@ namespace OpenSMOKE
 		*/
 		TransportPropertiesMap_CHEMKIN(rapidxml::xml_document<>& doc);
 
+		/**
+		*@brief Creates a transport map for the evaluation of transport properties, whose fitting coefficients
+				are provided in binary format (see ReadBinaryMechanismFile), in the same order of the XML file
+		*@param doc file in XML format
+		*@param coefficients fitting coefficients
+		*/
+		TransportPropertiesMap_CHEMKIN(rapidxml::xml_document<>& doc, const std::vector<double>& coefficients);
+
 		/**
 		*@brief Copy constructor
 		*@param rhs the object to be copied in the current object
@@ -110,6 +118,11 @@ namespace OpenSMOKE
 		*/
 		virtual void ImportCoefficientsFromXMLFile(rapidxml::xml_document<>& doc);
 
+		/**
+		*@brief Import the fitting coefficients provided in binary format (in the same order of the XML file)
+		*/
+		void ImportCoefficientsFromBinary(const std::vector<double>& coefficients);
+
 		/**
 		*@brief Import the species bundling coefficients from a file in XML format
 		*/
@@ -247,6 +260,17 @@ namespace OpenSMOKE
 		*/
 		void CopyFromMap(const TransportPropertiesMap_CHEMKIN& rhs);
 
+		/**
+		*@brief Reads the fitting coefficients (ASCII or binary input)
+		*/
+		template<typename Input>
+		void ImportFittingCoefficients(Input& fInput);
+
+		/**
+		*@brief Import the Lennard-Jones parameters from a file in XML format
+		*/
+		void ImportLennardJonesCoefficientsFromXMLFile(rapidxml::xml_document<>& doc);
+
 	private:
 
 		PhysicalConstants::OpenSMOKE_GasMixture_Viscosity_Model viscosity_model;
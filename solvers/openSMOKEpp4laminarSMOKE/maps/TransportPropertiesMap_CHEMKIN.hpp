@@ -82,6 +82,25 @@ namespace OpenSMOKE
 		ImportCoefficientsFromXMLFile(doc);
 	}
 
+	TransportPropertiesMap_CHEMKIN::TransportPropertiesMap_CHEMKIN(rapidxml::xml_document<>& doc, const std::vector<double>& coefficients)
+	{
+		temperature_lambda_must_be_recalculated_ = true;
+		temperature_eta_must_be_recalculated_ = true;
+		temperature_gamma_must_be_recalculated_ = true;
+		temperature_teta_must_be_recalculated_ = true;
+		pressure_gamma_must_be_recalculated_ = true;
+		this->T_ = this->P_ = 0.;
+		this->T_old_ = this->P_old_ = 0.;
+
+		this->species_bundling_ = false;
+
+		ImportSpeciesFromXMLFile(doc);
+		ImportViscosityModelFromXMLFile(doc);
+		MemoryAllocation();
+		ImportCoefficientsFromBinary(coefficients);
+		ImportLennardJonesCoefficientsFromXMLFile(doc);
+	}
+
 	TransportPropertiesMap_CHEMKIN::TransportPropertiesMap_CHEMKIN(const TransportPropertiesMap_CHEMKIN& rhs)
 	{
 		CopyFromMap(rhs);
@@ -154,6 +173,26 @@ namespace OpenSMOKE
 	{
 		this->nspecies_ = rhs.nspecies_;
 		this->species_bundling_ = rhs.species_bundling_;
+		this->viscosity_model = rhs.viscosity_model;
+
+		// The temperature-dependent properties are recalculated at the first call
+		temperature_lambda_must_be_recalculated_ = true;
+		temperature_eta_must_be_recalculated_ = true;
+		temperature_gamma_must_be_recalculated_ = true;
+		temperature_teta_must_be_recalculated_ = true;
+		pressure_gamma_must_be_recalculated_ = true;
+		this->T_ = this->P_ = 0.;
+		this->T_old_ = this->P_old_ = 0.;
+
+		this->index_H2O_ = rhs.index_H2O_;
+		this->index_CO2_ = rhs.index_CO2_;
+		this->index_CO_ = rhs.index_CO_;
+		this->index_CH4_ = rhs.index_CH4_;
+
+		this->is_lennard_jones_available_ = rhs.is_lennard_jones_available_;
+		this->mu_ = rhs.mu_;
+		this->sigma_ = rhs.sigma_;
+		this->epsilon_over_kb_ = rhs.epsilon_over_kb_;
 
 		MemoryAllocation();
 
@@ -212,6 +251,8 @@ namespace OpenSMOKE
 			this->bundling_reference_species_ = rhs.bundling_reference_species_;
 			this->bundling_groups_ = rhs.bundling_groups_;
 			this->bundling_species_group_ = rhs.bundling_species_group_;
+			this->bundling_sum_diffusion_coefficients_ = rhs.bundling_sum_diffusion_coefficients_;
+			this->bundling_sum_x_groups_ = rhs.bundling_sum_x_groups_;
 
 			this->bundling_fittingGammaSelfDiffusion_ = new double[4 * this->nspecies_];
 			this->bundling_fittingGamma_ = new double[this->bundling_number_groups_*(this->bundling_number_groups_ - 1) / 2 * 4];
@@ -338,13 +379,65 @@ namespace OpenSMOKE
 	}
 
 	void TransportPropertiesMap_CHEMKIN::ImportCoefficientsFromASCIIFile(std::istream& fInput)
+	{
+		ImportFittingCoefficients(fInput);
+
+		// Check that everything is read properly
+		std::string tag;
+		fInput >> tag;
+		CheckForFatalError(tag == "E");
+
+		// Complete the initialization
+		CompleteInitialization();
+	}
+
+	// Sequential reader of the fitting coefficients in binary format (the integer values are stored as doubles)
+	class TransportBinaryCoefficientsReader
+	{
+	public:
+
+		TransportBinaryCoefficientsReader(const std::vector<double>& coefficients) : coefficients_(coefficients), position_(0) {}
+
+		TransportBinaryCoefficientsReader& operator>>(double& value) { value = Next(); return *this; }
+		TransportBinaryCoefficientsReader& operator>>(unsigned int& value) { value = static_cast<unsigned int>(Next()); return *this; }
+
+		std::size_t position() const { return position_; }
+
+	private:
+
+		double Next()
+		{
+			if (position_ >= coefficients_.size())
+				ErrorMessage("TransportPropertiesMap_CHEMKIN::ImportCoefficientsFromBinary", "The binary transport coefficients are incomplete!");
+			return coefficients_[position_++];
+		}
+
+		const std::vector<double>& coefficients_;
+		std::size_t position_;
+	};
+
+	void TransportPropertiesMap_CHEMKIN::ImportCoefficientsFromBinary(const std::vector<double>& coefficients)
+	{
+		std::cout << " * Reading transport properties from binary data..." << std::endl;
+
+		TransportBinaryCoefficientsReader fInput(coefficients);
+		ImportFittingCoefficients(fInput);
+
+		// Check that everything is read properly
+		CheckForFatalError(fInput.position() == coefficients.size());
+
+		// Complete the initialization
+		CompleteInitialization();
+	}
+
+	template<typename Input>
+	void TransportPropertiesMap_CHEMKIN::ImportFittingCoefficients(Input& fInput)
 	{
 		{
 			fInput >> count_species_thermal_diffusion_ratios_;
 			fittingTeta = new double[4 * count_species_thermal_diffusion_ratios_*this->nspecies_];
 		}
 
-		std::string tag;
 		for (unsigned int j = 0; j < this->nspecies_; j++)
 		{
 			// Molecular weight
@@ -393,13 +486,6 @@ namespace OpenSMOKE
 				}
 			}
 		}
-
-		// Check that everything is read properly
-		fInput >> tag;
-		CheckForFatalError(tag == "E");
-
-		// Complete the initialization
-		CompleteInitialization();
 	}
 
 	void TransportPropertiesMap_CHEMKIN::ImportLennardJonesCoefficientsFromASCIIFile(std::istream& fInput)
@@ -435,12 +521,21 @@ namespace OpenSMOKE
 
 				ImportCoefficientsFromASCIIFile(fInput);
 			}
+			else if (transport_type == "CHEMKIN-binary")
+				ErrorMessage("TransportPropertiesMap_CHEMKIN::ImportCoefficientsFromXMLFile", "The transport coefficients are available in binary format only!");
 			else
 				ErrorMessage("TransportPropertiesMap_CHEMKIN::ImportCoefficientsFromXMLFile", "Transport type not supported!");
 		}
 		else
 			ErrorMessage("TransportPropertiesMap_CHEMKIN::ImportCoefficientsFromXMLFile", "Transport tag was not found!");
 
+		ImportLennardJonesCoefficientsFromXMLFile(doc);
+	}
+
+	void TransportPropertiesMap_CHEMKIN::ImportLennardJonesCoefficientsFromXMLFile(rapidxml::xml_document<>& doc)
+	{
+		rapidxml::xml_node<>* opensmoke_node = doc.first_node("opensmoke");
+
 		// Lennard-Jones parametes (not stricly needed)
 		rapidxml::xml_node<>* lennard_jones_node = opensmoke_node->first_node("Lennard-Jones");
 		if (lennard_jones_node != 0)
@@ -126,6 +126,56 @@ namespace OpenSMOKE
 	*/
 	void OpenInputFileXML(rapidxml::xml_document<>& doc, std::vector<char>& xml_copy, const boost::filesystem::path& file_name);
 
+	/**
+	*@brief Reads the content of a XML file (without parsing it)
+	*@param xml_copy the content of XML file (null-terminated)
+	*@param file_name the path to the XML file
+	*/
+	void ReadInputFileXML(std::vector<char>& xml_copy, const boost::filesystem::path& file_name);
+
+	/**
+	*@brief Parses a XML document already available in memory (the content is modified in place)
+	*@param doc the XML class
+	*@param xml_copy the content of XML file (null-terminated)
+	*/
+	void ParseXML(rapidxml::xml_document<>& doc, std::vector<char>& xml_copy);
+
+	/**
+	*@brief Returns the checksum (64-bit FNV-1a) of a sequence of bytes
+	*@param data the sequence of bytes
+	*@param n number of bytes
+	*@param checksum initial value (the checksum of the previous bytes, if any)
+	*/
+	unsigned long long ChecksumFNV1a(const char* data, const std::size_t n, const unsigned long long checksum = 14695981039346656037ULL);
+
+	/**
+	*@brief Returns the checksum of the content of a list of files (in the given order)
+	*@param file_names the paths to the files
+	*/
+	unsigned long long ChecksumOfFiles(const std::vector<boost::filesystem::path>& file_names);
+
+	/**
+	*@brief Writes the preprocessed kinetic mechanism on a binary file: a header (with the checksum of the
+	        original CHEMKIN files and the checksum of the content) followed by the content of the XML file
+	        and by the fitting coefficients of transport properties, which are stored as raw doubles (they 
+	        are by far the largest part of the XML file for large mechanisms, since the mass diffusion 
+	        coefficients scale with the square of the number of species)
+	*@param file_name the path to the binary file
+	*@param xml the content of the XML file
+	*@param source_checksum the checksum of the original CHEMKIN files
+	*/
+	void WriteBinaryMechanismFile(const boost::filesystem::path& file_name, const std::string& xml, const unsigned long long source_checksum);
+
+	/**
+	*@brief Reads the preprocessed kinetic mechanism from a binary file (memory-mapped) and checks its integrity
+	*@param xml_copy the content of the XML file (null-terminated), without the transport fitting coefficients
+	*@param transport_coefficients the fitting coefficients of transport properties (empty if not available),
+	        to be passed to the TransportPropertiesMap_CHEMKIN constructor
+	*@param file_name the path to the binary file
+	*@return the checksum of the original CHEMKIN files
+	*/
+	unsigned long long ReadBinaryMechanismFile(std::vector<char>& xml_copy, std::vector<double>& transport_coefficients, const boost::filesystem::path& file_name);
+
 	/**
 	*@brief Open a ASCII file
 	*@param fASCII the file stream
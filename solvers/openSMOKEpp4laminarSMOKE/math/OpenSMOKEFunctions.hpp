@@ -23,6 +23,9 @@
 #include <boost/math/constants/constants.hpp> 
 #include <boost/date_time.hpp>
 #include "boost/date_time/gregorian/gregorian.hpp"
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstring>
 
 #ifdef __APPLE__
 #include <mach-o/dyld.h>
@@ -324,6 +327,12 @@ namespace OpenSMOKE
 	}
 
 	void OpenInputFileXML(rapidxml::xml_document<>& doc, std::vector<char>& xml_copy, const boost::filesystem::path& file_name)
+	{
+		ReadInputFileXML(xml_copy, file_name);
+		ParseXML(doc, xml_copy);
+	}
+
+	void ReadInputFileXML(std::vector<char>& xml_copy, const boost::filesystem::path& file_name)
 	{
 		if (!boost::filesystem::exists(file_name))
 		{
@@ -345,10 +354,152 @@ namespace OpenSMOKE
 
 		xml_copy.assign(string_file.begin(), string_file.end());
 		xml_copy.push_back('\0');
+	}
 
+	void ParseXML(rapidxml::xml_document<>& doc, std::vector<char>& xml_copy)
+	{
 		doc.parse<rapidxml::parse_declaration_node | rapidxml::parse_no_data_nodes>(&xml_copy[0]);
 	}
 
+	// Header of binary files of preprocessed kinetic mechanisms
+	static const char OPENSMOKE_BINARY_MECHANISM_TAG[8] = { 'O', 'S', 'M', 'K', 'B', 'I', 'N', '\0' };
+	static const unsigned int OPENSMOKE_BINARY_MECHANISM_VERSION = 2;
+
+	unsigned long long ChecksumFNV1a(const char* data, const std::size_t n, const unsigned long long checksum)
+	{
+		unsigned long long hash = checksum;
+		for (std::size_t i = 0; i < n; i++)
+		{
+			hash ^= static_cast<unsigned char>(data[i]);
+			hash *= 1099511628211ULL;
+		}
+		return hash;
+	}
+
+	unsigned long long ChecksumOfFiles(const std::vector<boost::filesystem::path>& file_names)
+	{
+		unsigned long long checksum = ChecksumFNV1a(0, 0);
+		for (unsigned int i = 0; i < file_names.size(); i++)
+		{
+			std::ifstream fInput(file_names[i].string().c_str(), std::ios::in | std::ios::binary);
+			if (!fInput.is_open())
+				FatalErrorMessage("The " + file_names[i].string() + " file cannot be open!");
+
+			const std::string content = std::string(std::istreambuf_iterator<char>(fInput), std::istreambuf_iterator<char>());
+			checksum = ChecksumFNV1a(content.data(), content.size(), checksum);
+		}
+		return checksum;
+	}
+
+	void WriteBinaryMechanismFile(const boost::filesystem::path& file_name, const std::string& xml, const unsigned long long source_checksum)
+	{
+		std::ofstream fOutput(file_name.string().c_str(), std::ios::out | std::ios::binary);
+		if (!fOutput.is_open())
+			FatalErrorMessage("The " + file_name.string() + " file cannot be open!");
+
+		// The fitting coefficients of transport properties are moved from the XML content to a binary block
+		std::string xml_content = xml;
+		std::vector<double> transport_coefficients;
+		{
+			const std::string open_tag = "<Transport type=\"CHEMKIN\">";
+			const std::string close_tag = "</Transport>";
+			const std::size_t begin = xml_content.find(open_tag);
+			if (begin != std::string::npos)
+			{
+				const std::size_t end = xml_content.find(close_tag, begin);
+				if (end == std::string::npos)
+					FatalErrorMessage("WriteBinaryMechanismFile: the Transport tag is not closed");
+
+				const std::string block = xml_content.substr(begin + open_tag.size(), end - begin - open_tag.size());
+				const char* ptr = block.c_str();
+				for (;;)
+				{
+					char* next;
+					const double value = std::strtod(ptr, &next);
+					if (next == ptr)
+						break;
+					transport_coefficients.push_back(value);
+					ptr = next;
+				}
+
+				// The coefficients are followed by the E tag only
+				std::string tag(ptr);
+				tag.erase(0, tag.find_first_not_of(" \t\r\n"));
+				tag.erase(tag.find_last_not_of(" \t\r\n") + 1);
+				if (tag != "E")
+					FatalErrorMessage("WriteBinaryMechanismFile: wrong format of transport coefficients");
+
+				xml_content.replace(begin, end - begin, "<Transport type=\"CHEMKIN-binary\">");
+			}
+		}
+
+		const unsigned int version = OPENSMOKE_BINARY_MECHANISM_VERSION;
+		const unsigned long long size = xml_content.size();
+		const unsigned long long n_transport = transport_coefficients.size();
+		const char* transport_data = reinterpret_cast<const char*>(transport_coefficients.data());
+		const std::size_t transport_size = transport_coefficients.size() * sizeof(double);
+		const unsigned long long content_checksum = ChecksumFNV1a(transport_data, transport_size, ChecksumFNV1a(xml_content.data(), xml_content.size()));
+
+		fOutput.write(OPENSMOKE_BINARY_MECHANISM_TAG, sizeof(OPENSMOKE_BINARY_MECHANISM_TAG));
+		fOutput.write(reinterpret_cast<const char*>(&version), sizeof(version));
+		fOutput.write(reinterpret_cast<const char*>(&source_checksum), sizeof(source_checksum));
+		fOutput.write(reinterpret_cast<const char*>(&content_checksum), sizeof(content_checksum));
+		fOutput.write(reinterpret_cast<const char*>(&size), sizeof(size));
+		fOutput.write(reinterpret_cast<const char*>(&n_transport), sizeof(n_transport));
+		fOutput.write(xml_content.data(), xml_content.size());
+		fOutput.write(transport_data, transport_size);
+		fOutput.close();
+	}
+
+	unsigned long long ReadBinaryMechanismFile(std::vector<char>& xml_copy, std::vector<double>& transport_coefficients, const boost::filesystem::path& file_name)
+	{
+		if (!boost::filesystem::exists(file_name))
+			FatalErrorMessage("The " + file_name.string() + " file does not exist");
+
+		const std::size_t header_size = sizeof(OPENSMOKE_BINARY_MECHANISM_TAG) + sizeof(unsigned int) + 4 * sizeof(unsigned long long);
+		if (boost::filesystem::file_size(file_name) < header_size)
+			FatalErrorMessage("The " + file_name.string() + " file is not a binary kinetic mechanism");
+
+		// The file is mapped in memory and the content is copied only once
+		boost::interprocess::file_mapping file_mapping(file_name.string().c_str(), boost::interprocess::read_only);
+		boost::interprocess::mapped_region region(file_mapping, boost::interprocess::read_only);
+		const char* data = static_cast<const char*>(region.get_address());
+
+		unsigned int version;
+		unsigned long long source_checksum;
+		unsigned long long content_checksum;
+		unsigned long long size;
+		unsigned long long n_transport;
+
+		const char* ptr = data;
+		if (std::memcmp(ptr, OPENSMOKE_BINARY_MECHANISM_TAG, sizeof(OPENSMOKE_BINARY_MECHANISM_TAG)) != 0)
+			FatalErrorMessage("The " + file_name.string() + " file is not a binary kinetic mechanism");
+		ptr += sizeof(OPENSMOKE_BINARY_MECHANISM_TAG);
+		std::memcpy(&version, ptr, sizeof(version));				ptr += sizeof(version);
+		std::memcpy(&source_checksum, ptr, sizeof(source_checksum));	ptr += sizeof(source_checksum);
+		std::memcpy(&content_checksum, ptr, sizeof(content_checksum));	ptr += sizeof(content_checksum);
+		std::memcpy(&size, ptr, sizeof(size));					ptr += sizeof(size);
+
+		if (version != OPENSMOKE_BINARY_MECHANISM_VERSION)
+			FatalErrorMessage("The " + file_name.string() + " file was written with a different version of the preprocessor");
+
+		std::memcpy(&n_transport, ptr, sizeof(n_transport));			ptr += sizeof(n_transport);
+
+		const std::size_t transport_size = n_transport * sizeof(double);
+		if (region.get_size() != header_size + size + transport_size || 
+			ChecksumFNV1a(ptr + size, transport_size, ChecksumFNV1a(ptr, size)) != content_checksum)
+			FatalErrorMessage("The " + file_name.string() + " file is corrupted (wrong checksum)");
+
+		xml_copy.assign(ptr, ptr + size);
+		xml_copy.push_back('\0');
+
+		transport_coefficients.resize(n_transport);
+		if (n_transport != 0)
+			std::memcpy(transport_coefficients.data(), ptr + size, transport_size);
+
+		return source_checksum;
+	}
+
 	void OpenInputFileASCII(std::ifstream &fASCII, const boost::filesystem::path input_file_ascii)
 	{
 		if (!boost::filesystem::exists(input_file_ascii))
@@ -98,9 +98,7 @@ namespace OdeSMOKE
 	{
 		const double tstart = OpenSMOKE::OpenSMOKEGetCpuTime();
 
-		// TODO
-		// this->Jacobian(y, t, J_);
-		OpenSMOKE::ErrorMessage("KernelDense<ODESystemObject>", "User defined Jacobian is still not supported!");
+		this->Jacobian(y, t, J_);
 
 		const double tend = OpenSMOKE::OpenSMOKEGetCpuTime();
 
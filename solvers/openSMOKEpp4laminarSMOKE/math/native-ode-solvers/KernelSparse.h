@@ -78,7 +78,8 @@ namespace OdeSMOKE
 		void SetSparsityPattern(const std::vector<unsigned int>& i, const std::vector<unsigned int>& j);
 
 		/**
-		*@brief Function to set the solver for the solution of the dense linear system
+		*@brief Function to set the solver for the solution of the sparse linear system
+		It must be called before the initial conditions, since the symbolic analysis of the sparsity pattern is carried out only once
 		*@param linear_algebra_solver EigenSparseLU, EigenBiCGSTAB
 		*/
 		void SetLinearAlgebraSolver(const std::string linear_algebra_solver);
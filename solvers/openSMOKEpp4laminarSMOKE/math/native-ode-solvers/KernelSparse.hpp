@@ -430,53 +430,68 @@ namespace OdeSMOKE
 	template <typename ODESystemObject>
 	void KernelSparse<ODESystemObject>::BuildAndFactorizeMatrixG(const double hr0)
 	{
-		G_ = J_;
-		G_ *= -hr0;
-		G_ += ones_;
+		// G = I - hr0*J, written in place: the pattern of G (pattern of J plus the diagonal)
+		// never changes, so the symbolic analysis carried out in MemoryAllocationKernel is reused
+		for (int k = 0; k < G_.outerSize(); ++k)
+		{
+			Eigen::SparseMatrix<double>::InnerIterator it_J(J_, k);
+			for (Eigen::SparseMatrix<double>::InnerIterator it(G_, k); it; ++it)
+			{
+				double value = 0.;
+				if (it_J && it_J.row() == it.row())
+				{
+					value = -hr0*it_J.value();
+					++it_J;
+				}
+				if (it.row() == it.col())
+					value += 1.;
+				it.valueRef() = value;
+			}
+		}
 
 		const double tstart = OpenSMOKE::OpenSMOKEGetCpuTime();
 
 		if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_SPARSE_LU)
 		{
-			sparse_LU_.compute(G_);
+			sparse_LU_.factorize(G_);
 		}
 		else if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_BICGSTAB)
 		{
 			if (preconditionerType_ == OpenSMOKE::PRECONDITIONER_SPARSE_DIAGONAL)
-				sparse_bicgstab_diagonal_.compute(G_);
+				sparse_bicgstab_diagonal_.factorize(G_);
 			else if (preconditionerType_ == OpenSMOKE::PRECONDITIONER_SPARSE_ILUT)
-				sparse_bicgstab_ilut_.compute(G_);
+				sparse_bicgstab_ilut_.factorize(G_);
 		}
 		else if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_GMRES)
 		{
 			if (preconditionerType_ == OpenSMOKE::PRECONDITIONER_SPARSE_DIAGONAL)
-				sparse_gmres_diagonal_.compute(G_);
+				sparse_gmres_diagonal_.factorize(G_);
 			else if (preconditionerType_ == OpenSMOKE::PRECONDITIONER_SPARSE_ILUT)
-				sparse_gmres_ilut_.compute(G_);
+				sparse_gmres_ilut_.factorize(G_);
 		}
 		else if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_DGMRES)
 		{
 			if (preconditionerType_ == OpenSMOKE::PRECONDITIONER_SPARSE_DIAGONAL)
-				sparse_dgmres_diagonal_.compute(G_);
+				sparse_dgmres_diagonal_.factorize(G_);
 			else if (preconditionerType_ == OpenSMOKE::PRECONDITIONER_SPARSE_ILUT)
-				sparse_dgmres_ilut_.compute(G_);
+				sparse_dgmres_ilut_.factorize(G_);
 		}
 		#if OPENSMOKE_USE_MKL == 1
 		else if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_PARDISO)
 		{
-			sparse_pardiso_.compute(G_);
+			sparse_pardiso_.factorize(G_);
 		}
 		#endif
 		#if OPENSMOKE_USE_SUPERLU_SERIAL == 1
 		else if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_SUPERLU_SERIAL)
 		{
-			sparse_superlu_serial_.compute(G_);
+			sparse_superlu_serial_.factorize(G_);
 		}
 		#endif
 		#if OPENSMOKE_USE_UMFPACK == 1
 		else if (solverType_ == OpenSMOKE::SOLVER_SPARSE_EIGEN_UMFPACK)
 		{
-			sparse_umfpack_.compute(G_);
+			sparse_umfpack_.factorize(G_);
 		}
 		#endif
 		#if OPENSMOKE_USE_LIS == 1